@@ -0,0 +1,82 @@
+#ifndef CORPUS_H
+#define CORPUS_H
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+/// @brief Generates a program by repeating a snippet using most of the language
+inline std::string generateCorpus(std::size_t repetitions) {
+    static const std::string snippet{
+        "struct Point {\n"
+        "    int x,\n"
+        "    float y\n"
+        "}\n"
+        "# Sums all numbers up to the limit\n"
+        "int sum(int limit) {\n"
+        "    int result = 0;\n"
+        "    int i = 1;\n"
+        "    while i <= limit and result >= 0 {\n"
+        "        result = result + i * 2 - 1 / 1;\n"
+        "        i = i + 1;\n"
+        "    }\n"
+        "    return result;\n"
+        "}\n"
+        "Point p = {12, 3.25};\n"
+        "if p.x != 0 or not false {\n"
+        "    print \"sum: \" + sum(p.x) as str;\n"
+        "}\n"};
+
+    std::string corpus;
+    corpus.reserve(snippet.size() * repetitions);
+    for (std::size_t i{0}; i < repetitions; ++i)
+        corpus += snippet;
+    return corpus;
+}
+
+/// @brief Generates a data table, i.e. a program made mostly of numeric literals
+inline std::string generateNumericCorpus(std::size_t rows) {
+    std::string corpus;
+    corpus.reserve(64 * rows);
+
+    // Deterministic pseudo-random values, so every run lexes the same text
+    std::uint32_t state{12345};
+    auto next = [&state] {
+        state = state * 1664525 + 1013904223;
+        return state >> 8;
+    };
+
+    for (std::size_t i{0}; i < rows; ++i) {
+        corpus += "Row r = {" + std::to_string(next() % 1'000'000) + ", ";
+        corpus += std::to_string(next() % 10'000) + "." + std::to_string(next() % 1000);
+        corpus += ", " + std::to_string(next()) + ", 0.";
+        corpus += std::to_string(next()) + "};\n";
+    }
+    return corpus;
+}
+
+/// @brief Generates a program made only of function definitions, all of which are kept
+/// when the program is run statement by statement
+inline std::string generateDefinitions(std::size_t count) {
+    std::string corpus;
+    corpus.reserve(64 * count);
+
+    for (std::size_t i{0}; i < count; ++i) {
+        const auto n = std::to_string(i);
+        corpus += "int f" + n + "(int a, int b) {\n";
+        corpus += "    int c = a + b * " + n + ";\n";
+        corpus += "    return c;\n}\n";
+    }
+    return corpus;
+}
+
+/// @brief Reads the whole file into memory
+inline std::string readFile(const std::string& path) {
+    std::ifstream ifs(path);
+    std::stringstream contents;
+    contents << ifs.rdbuf();
+    return contents.str();
+}
+
+#endif
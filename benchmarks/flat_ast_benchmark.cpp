@@ -0,0 +1,45 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "corpus.hpp"
+#include "filter.hpp"
+#include "flat_ast.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+
+/// Compares the memory taken by the parse tree with its flat form and measures how long
+/// the conversion takes, e.g.
+///
+///   ./flat_ast_benchmark              converts a generated corpus of about 50 MiB
+///   ./flat_ast_benchmark script.rp    converts the given file
+int main(int argc, char* argv[]) {
+    const auto corpus = argc > 1 ? readFile(argv[1]) : generateCorpus(150'000);
+
+    auto source = Source(std::string_view(corpus));
+    auto lexer = Lexer(source);
+    auto filter = BasicFilter<Lexer, Token::Type::CMT>(lexer);
+    auto parser = Parser(filter);
+    const auto program = parser.parseProgram();
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto ast = flatten(program);
+    const auto flattened = std::chrono::steady_clock::now();
+
+    // Queries touching a single field of every node read only that array
+    std::size_t constantCount{0};
+    for (FlatAst::Index node{0}; node < ast.getNodeCount(); ++node)
+        constantCount += ast.getKind(node) == NodeKind::CONSTANT;
+    const auto counted = std::chrono::steady_clock::now();
+
+    const std::chrono::duration<double> flattening = flattened - start;
+    const std::chrono::duration<double> counting = counted - flattened;
+    constexpr double mebibyte = 1024 * 1024;
+    std::cout << ast.getNodeCount() << " nodes, " << constantCount << " constants\n"
+              << "parse tree: "
+              << static_cast<double>(program.arena->getByteSize()) / mebibyte
+              << " MiB, flat: " << static_cast<double>(ast.getByteSize()) / mebibyte
+              << " MiB\n"
+              << "flattened in " << flattening.count() << " s, constants counted in "
+              << counting.count() << " s\n";
+}
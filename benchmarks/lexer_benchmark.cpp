@@ -0,0 +1,34 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "corpus.hpp"
+#include "lexer.hpp"
+
+/// Measures how many tokens per second Lexer produces, both keeping and discarding
+/// comments, e.g.
+///
+///   ./lexer_benchmark              lexes a generated corpus of about 50 MiB
+///   ./lexer_benchmark script.rp    lexes the given file
+int main(int argc, char* argv[]) {
+    const auto corpus = argc > 1 ? readFile(argv[1]) : generateCorpus(150'000);
+
+    for (const auto commentMode :
+         {Lexer::CommentMode::KEEP, Lexer::CommentMode::DISCARD}) {
+        const auto start = std::chrono::steady_clock::now();
+
+        auto source = Source(std::string_view(corpus));
+        auto lexer = Lexer(source, commentMode);
+        std::size_t tokens{0};
+        while (lexer.getToken().getType() != Token::Type::ETX)
+            ++tokens;
+
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        const auto megabytes = static_cast<double>(corpus.size()) / (1024 * 1024);
+        std::cout << (commentMode == Lexer::CommentMode::KEEP ? "Keeping" : "Discarding")
+                  << " comments: " << tokens << " tokens from " << megabytes << " MiB in "
+                  << elapsed.count() << " s (" << tokens / elapsed.count() / 1e6
+                  << " M tokens/s, " << megabytes / elapsed.count() << " MiB/s)\n";
+    }
+}
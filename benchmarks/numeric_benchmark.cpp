@@ -0,0 +1,37 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "corpus.hpp"
+#include "lexer.hpp"
+
+/// Measures how fast Lexer converts numeric literals, e.g.
+///
+///   ./numeric_benchmark              lexes a generated data table of about 50 MiB
+///   ./numeric_benchmark table.rp     lexes the given file
+int main(int argc, char* argv[]) {
+    const auto corpus = argc > 1 ? readFile(argv[1]) : generateNumericCorpus(1'000'000);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    auto source = Source(std::string_view(corpus));
+    auto lexer = Lexer(source);
+    std::size_t tokens{0};
+    std::size_t numbers{0};
+    while (true) {
+        const auto type = lexer.getToken().getType();
+        if (type == Token::Type::ETX)
+            break;
+        ++tokens;
+        if (type == Token::Type::INT_CONST || type == Token::Type::FLOAT_CONST)
+            ++numbers;
+    }
+
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    const auto megabytes = static_cast<double>(corpus.size()) / (1024 * 1024);
+    std::cout << tokens << " tokens (" << numbers << " numeric) from " << megabytes
+              << " MiB in " << elapsed.count() << " s ("
+              << numbers / elapsed.count() / 1e6 << " M numbers/s, "
+              << megabytes / elapsed.count() << " MiB/s)\n";
+}
@@ -0,0 +1,39 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "corpus.hpp"
+#include "parallel_lexer.hpp"
+
+/// Measures how ParallelLexer scales with the number of threads, e.g.
+///
+///   ./parallel_lexer_benchmark              lexes a generated corpus of about 50 MiB
+///   ./parallel_lexer_benchmark 8            uses 1 to 8 threads
+///   ./parallel_lexer_benchmark 8 script.rp  lexes the given file
+int main(int argc, char* argv[]) {
+    const unsigned int maxThreads =
+        argc > 1 ? std::stoul(argv[1])
+                 : std::max(std::thread::hardware_concurrency(), 1u);
+    const auto corpus = argc > 2 ? readFile(argv[2]) : generateCorpus(150'000);
+    const auto megabytes = static_cast<double>(corpus.size()) / (1024 * 1024);
+
+    double singleThreadTime{0};
+    for (unsigned int threads{1}; threads <= maxThreads; ++threads) {
+        const auto start = std::chrono::steady_clock::now();
+
+        auto lexer = ParallelLexer(corpus, threads);
+        std::size_t tokens{0};
+        while (lexer.getToken().getType() != Token::Type::ETX)
+            ++tokens;
+
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (threads == 1)
+            singleThreadTime = elapsed.count();
+
+        std::cout << threads << " threads: " << tokens << " tokens in " << elapsed.count()
+                  << " s (" << megabytes / elapsed.count() << " MiB/s, speedup "
+                  << singleThreadTime / elapsed.count() << ")\n";
+    }
+}
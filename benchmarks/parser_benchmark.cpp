@@ -0,0 +1,68 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "corpus.hpp"
+#include "filter.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+
+/// @brief Returns the number of bytes in the arenas of the definitions parsed as a whole
+/// program and one statement at a time (as in the pipelined mode, which keeps them all)
+std::pair<std::size_t, std::size_t> measureDefinitionArenas(std::string_view corpus) {
+    auto wholeSource = Source(corpus);
+    auto wholeLexer = Lexer(wholeSource);
+    const auto program = Parser(wholeLexer).parseProgram();
+
+    auto source = Source(corpus);
+    auto lexer = Lexer(source);
+    auto parser = Parser(lexer);
+    std::size_t fragmentBytes{0};
+    while (true) {
+        const auto fragment = parser.parseNextStatement();
+        if (fragment.statements.empty())
+            break;
+        fragmentBytes += fragment.arena->getByteSize();
+    }
+    return {program.arena->getByteSize(), fragmentBytes};
+}
+
+/// Measures how fast the front end (Lexer, Filter and Parser) builds the parse tree and
+/// how long it takes to free it. Then compares the memory taken by arenas of a program
+/// made of definitions parsed as a whole and one statement at a time, e.g.
+///
+///   ./parser_benchmark              parses a generated corpus of about 50 MiB
+///   ./parser_benchmark script.rp    parses the given file
+int main(int argc, char* argv[]) {
+    const auto corpus = argc > 1 ? readFile(argv[1]) : generateCorpus(150'000);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    auto source = Source(std::string_view(corpus));
+    auto lexer = Lexer(source);
+    auto filter = BasicFilter<Lexer, Token::Type::CMT>(lexer);
+    auto parser = Parser(filter);
+    auto program = parser.parseProgram();
+
+    const auto parsed = std::chrono::steady_clock::now();
+    const auto statementCount = program.statements.size();
+    program = {};
+
+    const std::chrono::duration<double> elapsed = parsed - start;
+    const std::chrono::duration<double> freeing =
+        std::chrono::steady_clock::now() - parsed;
+    const auto megabytes = static_cast<double>(corpus.size()) / (1024 * 1024);
+    std::cout << statementCount << " statements from " << megabytes << " MiB in "
+              << elapsed.count() << " s (" << megabytes / elapsed.count()
+              << " MiB/s), freed in " << freeing.count() << " s\n";
+
+    constexpr std::size_t definitionCount{100'000};
+    const auto [wholeBytes, fragmentBytes] =
+        measureDefinitionArenas(generateDefinitions(definitionCount));
+    constexpr double mebibyte{1024 * 1024};
+    std::cout << definitionCount << " definitions take " << wholeBytes / mebibyte
+              << " MiB of arenas as a program, " << fragmentBytes / mebibyte
+              << " MiB one statement at a time\n";
+}
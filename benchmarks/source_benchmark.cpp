@@ -0,0 +1,36 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "source.hpp"
+
+/// Measures how fast Source walks piped input, e.g.
+///
+///   yes 'int counter = counter + 1; # increment' | head -c 200M | ./source_benchmark 1
+///
+/// A block size of 1 reads the stream one character at a time, which is how Source
+/// used to consume streams. Block size defaults to Source::defaultBlockSize
+int main(int argc, char* argv[]) {
+    const std::size_t blockSize =
+        argc > 1 ? std::stoul(argv[1]) : Source::defaultBlockSize;
+    const std::string path = argc > 2 ? argv[2] : "/dev/stdin";
+
+    std::ifstream ifs(path);
+    const auto start = std::chrono::steady_clock::now();
+
+    auto source = Source(ifs, blockSize);
+    std::size_t chars{0};
+    while (source.getChar() != EOF) {
+        source.nextChar();
+        ++chars;
+    }
+
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    const auto megabytes = static_cast<double>(chars) / (1024 * 1024);
+    std::cout << "block size " << blockSize << ": " << chars << " chars, "
+              << source.getLineIndex().getLineColumn(source.getPosition()).line
+              << " lines in " << elapsed.count() << " s ("
+              << megabytes / elapsed.count() << " MiB/s)\n";
+}
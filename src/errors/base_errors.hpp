@@ -4,6 +4,7 @@
 #include <stdexcept>
 #include <string>
 
+#include "line_index.hpp"
 #include "position.hpp"
 
 /// @brief Abstract class for exceptions
@@ -12,8 +13,9 @@ class BaseException : public std::runtime_error {
     BaseException(const Position& position, const std::string& message);
 
     /// @brief Provides std::string representation of exception
+    /// @param lineIndex of the source in which the exception occurred
     /// @return std::string representation of exception
-    std::string describe() const;
+    std::string describe(const LineIndex& lineIndex) const;
     const Position& getPosition() const { return position_; }
 
    private:
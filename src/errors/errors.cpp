@@ -5,16 +5,16 @@
 #include "magic_enum/magic_enum.hpp"
 
 BaseException::BaseException(const Position& position, const std::string& message)
-    : std::runtime_error(" at " + std::to_string(position.line) + ':'
-                         + std::to_string(position.column) + '\n' + message),
-      position_(position) {}
+    : std::runtime_error(message), position_(position) {}
 
 std::string BaseException::getName() const {
     return typeid(*this).name();
 }
 
-std::string BaseException::describe() const {
-    return getName() + what();
+std::string BaseException::describe(const LineIndex& lineIndex) const {
+    const auto lineColumn = lineIndex.getLineColumn(position_);
+    return getName() + " at " + std::to_string(lineColumn.line) + ':'
+           + std::to_string(lineColumn.column) + '\n' + what();
 }
 
 InvalidToken::InvalidToken(const Position& position, char c)
@@ -38,13 +38,17 @@ NumericOverflow::NumericOverflow(const Position& position, Integral value, Integ
 InvalidFloat::InvalidFloat(const Position& position)
     : BaseException(position, "Expected digit after '.' in float literal") {}
 
-struct TypeToString {
-    std::string operator()(BuiltInType type) {
-        return std::string(magic_enum::enum_name(type));
-    }
-    std::string operator()(const std::string& type) { return type; }
-    std::string operator()(const VoidType&) { return "VOID"; }
-};
+InvalidUtf8::InvalidUtf8(const Position& position)
+    : BaseException(position, "Encountered invalid UTF-8 sequence") {}
+
+SourceTooLarge::SourceTooLarge()
+    : BaseException({Position::maxOffset},
+                    "Source does not fit into 4 GiB, offsets past this one cannot be "
+                    "represented") {}
+
+std::string TypeToString::operator()(BuiltInType type) const {
+    return std::string(magic_enum::enum_name(type));
+}
 
 SymbolNotFound::SymbolNotFound(const Position& position, std::string type,
                                std::string symbol)
@@ -55,19 +59,18 @@ SymbolNotFound::SymbolNotFound(const Position& position, std::string type,
 SymbolNotFound::SymbolNotFound(const Position& position, const SymbolNotFound& e)
     : SymbolNotFound{position, e.type_, e.symbol_} {}
 
-TypeMismatch::TypeMismatch(const Position& position, Type expected, Type actual)
-    : BaseException{position, "Expected: " + std::visit(TypeToString(), expected)
-                                  + "\nActual: " + std::visit(TypeToString(), actual)},
+TypeMismatch::TypeMismatch(const Position& position, std::string expected,
+                           std::string actual)
+    : BaseException{position, "Expected: " + expected + "\nActual: " + actual},
       expected_{expected},
       actual_{actual} {}
 
 TypeMismatch::TypeMismatch(const Position& position, const TypeMismatch& e)
     : TypeMismatch{position, e.expected_, e.actual_} {}
 
-ReturnTypeMismatch::ReturnTypeMismatch(const Position& position, ReturnType expected,
-                                       ReturnType actual)
-    : BaseException{position, "Expected: " + std::visit(TypeToString(), expected)
-                                  + "\nActual: " + std::visit(TypeToString(), actual)},
+ReturnTypeMismatch::ReturnTypeMismatch(const Position& position, std::string expected,
+                                       std::string actual)
+    : BaseException{position, "Expected: " + expected + "\nActual: " + actual},
       expected_{expected},
       actual_{actual} {}
 
@@ -102,10 +105,10 @@ struct ValueToString {
     std::string operator()(const std::string&) const { return "STR"; }
     std::string operator()(const StructObj&) const { return "Anonymous struct"; }
     std::string operator()(const NamedStructObj& s) const {
-        return "Struct " + s.structDef->name;
+        return "Struct " + std::string(s.structDef->name.getName());
     }
     std::string operator()(const VariantObj& v) const {
-        return "Variant " + v.variantDef->name;
+        return "Variant " + std::string(v.variantDef->name.getName());
     }
 };
 
@@ -5,6 +5,13 @@
 #include "types.hpp"
 #include "value_obj.hpp"
 
+/// @brief Returns the name of a type shown in error messages
+struct TypeToString {
+    std::string operator()(BuiltInType type) const;
+    std::string operator()(Symbol type) const { return std::string(type.getName()); }
+    std::string operator()(VoidType) const { return "VOID"; }
+};
+
 class SymbolNotFound : public BaseException {
    public:
     SymbolNotFound(const Position& position, std::string type, std::string symbol);
@@ -17,22 +24,23 @@ class SymbolNotFound : public BaseException {
 
 class TypeMismatch : public BaseException {
    public:
-    TypeMismatch(const Position& position, Type expected, Type actual);
+    TypeMismatch(const Position& position, std::string expected, std::string actual);
     TypeMismatch(const Position& position, const TypeMismatch& e);
 
    private:
-    Type expected_;
-    Type actual_;
+    std::string expected_;
+    std::string actual_;
 };
 
 class ReturnTypeMismatch : public BaseException {
    public:
-    ReturnTypeMismatch(const Position& position, ReturnType expected, ReturnType actual);
+    ReturnTypeMismatch(const Position& position, std::string expected,
+                       std::string actual);
     ReturnTypeMismatch(const Position& position, const ReturnTypeMismatch& e);
 
    private:
-    ReturnType expected_;
-    ReturnType actual_;
+    std::string expected_;
+    std::string actual_;
 };
 
 class InvalidFieldCount : public BaseException {
@@ -29,4 +29,14 @@ class InvalidFloat : public BaseException {
     explicit InvalidFloat(const Position& position);
 };
 
+class InvalidUtf8 : public BaseException {
+   public:
+    explicit InvalidUtf8(const Position& position);
+};
+
+class SourceTooLarge : public BaseException {
+   public:
+    SourceTooLarge();
+};
+
 #endif
@@ -3,7 +3,7 @@
 #include <algorithm>
 #include <ranges>
 
-std::optional<RefObj> CallContext::getVariable(std::string_view name) const {
+std::optional<RefObj> CallContext::getVariable(Symbol name) const {
     for (const auto& scope : std::ranges::views::reverse(scopes_))
         if (const auto& varRef = scope.getVariable(name))
             return *varRef;
@@ -19,7 +19,7 @@ std::optional<RefObj> CallContext::getVariable(std::string_view name) const {
 }
 
 std::optional<CallContext::FuncWithCtx> CallContext::getFunctionWithCtx(
-    std::string_view name) const {
+    Symbol name) const {
     for (auto const& scope : std::ranges::views::reverse(scopes_))
         if (const auto& func = scope.getFunction(name))
             return std::make_pair(func, this);
@@ -30,7 +30,7 @@ std::optional<CallContext::FuncWithCtx> CallContext::getFunctionWithCtx(
     return std::nullopt;
 }
 
-const StructDef* CallContext::getStructDef(std::string_view name) const {
+const StructDef* CallContext::getStructDef(Symbol name) const {
     for (auto const& scope : std::ranges::views::reverse(scopes_))
         if (const auto& structDef = scope.getStructDef(name))
             return structDef;
@@ -42,7 +42,7 @@ const StructDef* CallContext::getStructDef(std::string_view name) const {
     return nullptr;
 }
 
-const VariantDef* CallContext::getVariantDef(std::string_view name) const {
+const VariantDef* CallContext::getVariantDef(Symbol name) const {
     for (auto const& scope : std::ranges::views::reverse(scopes_))
         if (auto variantDef = scope.getVariantDef(name))
             return variantDef;
@@ -5,7 +5,7 @@
 
 #include "scope.hpp"
 
-using RefEntry = std::pair<std::string, RefObj>;
+using RefEntry = std::pair<Symbol, RefObj>;
 
 /// @brief Function call context
 class CallContext {
@@ -29,16 +29,18 @@ class CallContext {
 
     void addScope() { scopes_.emplace_back(); }
     void removeScope() { scopes_.pop_back(); }
+    /// @brief Removes all scopes but the outermost one
+    void removeNestedScopes() { scopes_.erase(scopes_.begin() + 1, scopes_.end()); }
 
-    std::optional<RefObj> getVariable(std::string_view name) const;
+    std::optional<RefObj> getVariable(Symbol name) const;
 
     /// @brief Returns a function with the given name along with the call context in which
     /// the function is defined
     /// @param name Named of the function
     /// @return
-    std::optional<FuncWithCtx> getFunctionWithCtx(std::string_view name) const;
-    const StructDef* getStructDef(std::string_view name) const;
-    const VariantDef* getVariantDef(std::string_view name) const;
+    std::optional<FuncWithCtx> getFunctionWithCtx(Symbol name) const;
+    const StructDef* getStructDef(Symbol name) const;
+    const VariantDef* getVariantDef(Symbol name) const;
 
    private:
     const CallContext* parentContext_{nullptr};
@@ -31,8 +31,8 @@ bool ExpressionInterpreter::getBoolValue(const Expression& expr) const {
     const auto valueObj = getExprValue(expr);
     const auto boolValue = std::get_if<bool>(&valueObj.value);
     if (!boolValue)
-        throw TypeMismatch{expr.position, BuiltInType::BOOL,
-                           std::visit(ValueToType(), valueObj.value)};
+        throw TypeMismatch{expr.position, TypeToString()(BuiltInType::BOOL),
+                           std::visit(ValueToTypeName(), valueObj.value)};
 
     return *boolValue;
 }
@@ -66,7 +66,7 @@ struct EqualityEvaluator {
         return func_(lhs, rhs);
     }
     bool operator()(const auto& lhs, const auto& rhs) const {
-        throw TypeMismatch{{}, ValueToType()(lhs), ValueToType()(rhs)};
+        throw TypeMismatch{{}, ValueToTypeName()(lhs), ValueToTypeName()(rhs)};
     }
 
    private:
@@ -106,7 +106,7 @@ struct ComparisonEvaluator {
         return func_(lhs, rhs);
     }
     bool operator()(const auto& lhs, const auto& rhs) {
-        throw TypeMismatch{{}, ValueToType()(lhs), ValueToType()(rhs)};
+        throw TypeMismatch{{}, ValueToTypeName()(lhs), ValueToTypeName()(rhs)};
     }
 
     Functor func_;
@@ -155,7 +155,7 @@ struct NumericEvaluator {
         return func_(lhs, rhs);
     }
     ValueObj::Value operator()(const auto& lhs, const auto& rhs) const {
-        throw TypeMismatch{{}, ValueToType()(lhs), ValueToType()(rhs)};
+        throw TypeMismatch{{}, ValueToTypeName()(lhs), ValueToTypeName()(rhs)};
     }
 
     Functor func_;
@@ -176,7 +176,7 @@ struct NumericEvaluator<std::divides<>> {
         return lhs / rhs;
     }
     ValueObj::Value operator()(const auto& lhs, const auto& rhs) const {
-        throw TypeMismatch{{}, ValueToType()(lhs), ValueToType()(rhs)};
+        throw TypeMismatch{{}, ValueToTypeName()(lhs), ValueToTypeName()(rhs)};
     }
 };
 
@@ -234,7 +234,7 @@ struct SignChangeEvaluator {
     ValueObj::Value operator()(Integral i) { return -i; }
     ValueObj::Value operator()(Floating i) { return -i; }
     ValueObj::Value operator()(const auto& i) {
-        throw TypeMismatch{{}, "Numeric", ValueToType()(i)};
+        throw TypeMismatch{{}, "Numeric", ValueToTypeName()(i)};
     }
 };
 
@@ -281,22 +281,22 @@ struct TypeConverter {
             return from;
         throw InvalidTypeConversion{{}, std::move(from), to};
     }
-    ValueObj::Value operator()(NamedStructObj from, const std::string& to) const {
+    ValueObj::Value operator()(NamedStructObj from, Symbol to) const {
         if (from.structDef->name == to)
             return from;
         return convertToVariant(std::move(from), to);
     }
 
-    ValueObj::Value operator()(Integral from, const std::string& to) const {
+    ValueObj::Value operator()(Integral from, Symbol to) const {
         return convertToVariant(from, to);
     }
-    ValueObj::Value operator()(Floating from, const std::string& to) const {
+    ValueObj::Value operator()(Floating from, Symbol to) const {
         return convertToVariant(from, to);
     }
-    ValueObj::Value operator()(bool from, const std::string& to) const {
+    ValueObj::Value operator()(bool from, Symbol to) const {
         return convertToVariant(from, to);
     }
-    ValueObj::Value operator()(std::string from, const std::string& to) const {
+    ValueObj::Value operator()(std::string from, Symbol to) const {
         return convertToVariant(std::move(from), to);
     }
 
@@ -318,7 +318,7 @@ struct TypeConverter {
         }
     }
 
-    ValueObj::Value convertToVariant(auto from, const std::string& to) const {
+    ValueObj::Value convertToVariant(auto from, Symbol to) const {
         const auto variantDef = interpreter_->getVariantDef(to);
         if (!variantDef)
             throw InvalidTypeConversion{{}, std::move(from), to};
@@ -390,7 +390,7 @@ struct FieldAccessEvaluator {
         const auto namedStructObj = std::get_if<NamedStructObj>(&valueObj.value);
         if (!namedStructObj)
             throw TypeMismatch{expr_.position, "Named struct",
-                               std::visit(ValueToType(), valueObj.value)};
+                               std::visit(ValueToTypeName(), valueObj.value)};
 
         try {
             return namedStructObj->getField(expr_.field);
@@ -424,6 +424,6 @@ void ExpressionInterpreter::operator()(const FuncCall& funcCall) const {
 void ExpressionInterpreter::operator()(const VariableAccess& expr) const {
     auto varRef = interpreter_->getVariable(expr.name);
     if (!varRef)
-        throw SymbolNotFound{expr.position, "Variable", expr.name};
+        throw SymbolNotFound{expr.position, "Variable", std::string(expr.name.getName())};
     lastResult_ = *varRef;
 }
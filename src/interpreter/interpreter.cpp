@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <iostream>
 #include <ranges>
+#include <utility>
 
 #include "expr_interpreter.hpp"
 #include "interpreter_errors.hpp"
@@ -13,14 +14,72 @@ Interpreter::Interpreter(std::ostream& out)
 }
 
 void Interpreter::interpret(const Program& program) {
-    for (const auto& stmt : program.statements) {
-        stmt->accept(*this);
+    for (const auto& stmt : program.statements)
+        interpret(*stmt);
+}
+
+void Interpreter::interpret(const Statement& stmt) {
+    try {
+        stmt.accept(*this);
         if (returning_)
-            throw ReturnTypeMismatch{stmt->position, "No return in global scope",
+            throw ReturnTypeMismatch{stmt.position, "No return in global scope",
                                      "Returning in global scope"};
+    } catch (...) {
+        // Leave the calls and blocks the error occurred in
+        while (callStack_.size() > 1)
+            callStack_.pop();
+        callStack_.top().removeNestedScopes();
+        returnValue_ = std::nullopt;
+        returning_ = false;
+        throw;
     }
 }
 
+/// @brief Checks if the statement (or any statement nested in it) defines a function,
+/// struct or variant
+class DefinitionFinder : public StatementVisitor {
+   public:
+    bool find(const Statement& stmt) {
+        stmt.accept(*this);
+        return found_;
+    }
+
+    void operator()(const IfStatement& stmt) override { findIn(stmt.statements); }
+    void operator()(const WhileStatement& stmt) override { findIn(stmt.statements); }
+    void operator()(const ReturnStatement&) override {}
+    void operator()(const PrintStatement&) override {}
+    void operator()(const FuncDef&) override { found_ = true; }
+    void operator()(const Assignment&) override {}
+    void operator()(const VarDef&) override {}
+    void operator()(const FuncCall&) override {}
+    void operator()(const StructDef&) override { found_ = true; }
+    void operator()(const VariantDef&) override { found_ = true; }
+
+   private:
+    void findIn(const Statements& statements) {
+        for (const auto& stmt : statements) {
+            if (found_)
+                return;
+            stmt->accept(*this);
+        }
+    }
+
+    bool found_{false};
+};
+
+void Interpreter::interpret(Program&& program) {
+    const bool definesAnything =
+        std::ranges::any_of(program.statements, [](const PStatement& stmt) {
+            return DefinitionFinder().find(*stmt);
+        });
+    if (!definesAnything) {
+        interpret(std::as_const(program));
+        return;
+    }
+    // Kept before running, as scopes may point into it even if running fails
+    interpret(std::as_const(definitions_.emplace_back(std::move(program))));
+}
+
 void Interpreter::addVariable(VarEntry entry) {
     callStack_.top().addVariable(std::move(entry));
 }
@@ -31,34 +90,34 @@ void Interpreter::addFunction(const FuncDef* funcDef) {
 
 void Interpreter::addStruct(const StructDef* structDef) {
     if (getStructDef(structDef->name))
-        throw StructRedefinition{{}, structDef->name};
+        throw StructRedefinition{{}, std::string(structDef->name.getName())};
     if (getVariantDef(structDef->name))
-        throw VariantRedefinition{{}, structDef->name};
+        throw VariantRedefinition{{}, std::string(structDef->name.getName())};
     callStack_.top().addStruct(structDef);
 }
 
 void Interpreter::addVariant(const VariantDef* variantDef) {
     if (getVariantDef(variantDef->name))
-        throw VariantRedefinition{{}, variantDef->name};
+        throw VariantRedefinition{{}, std::string(variantDef->name.getName())};
     if (getStructDef(variantDef->name))
-        throw StructRedefinition{{}, variantDef->name};
+        throw StructRedefinition{{}, std::string(variantDef->name.getName())};
     callStack_.top().addVariant(variantDef);
 }
 
-std::optional<RefObj> Interpreter::getVariable(std::string_view name) const {
+std::optional<RefObj> Interpreter::getVariable(Symbol name) const {
     return callStack_.top().getVariable(name);
 }
 
 std::optional<CallContext::FuncWithCtx> Interpreter::getFunctionWithCtx(
-    std::string_view name) const {
+    Symbol name) const {
     return callStack_.top().getFunctionWithCtx(name);
 }
 
-const StructDef* Interpreter::getStructDef(std::string_view name) const {
+const StructDef* Interpreter::getStructDef(Symbol name) const {
     return callStack_.top().getStructDef(name);
 }
 
-const VariantDef* Interpreter::getVariantDef(std::string_view name) const {
+const VariantDef* Interpreter::getVariantDef(Symbol name) const {
     return callStack_.top().getVariantDef(name);
 }
 
@@ -71,8 +130,8 @@ bool Interpreter::evaluateCondition(const ConditionalStatement& stmt) {
     const auto conditionValue = getHeldValue(getValueFromExpr(*stmt.condition));
     const auto condition = std::get_if<bool>(&conditionValue.value);
     if (!condition)
-        throw TypeMismatch{stmt.condition->position, BuiltInType::BOOL,
-                           std::visit(ValueToType(), conditionValue.value)};
+        throw TypeMismatch{stmt.condition->position, TypeToString()(BuiltInType::BOOL),
+                           std::visit(ValueToTypeName(), conditionValue.value)};
     return *condition;
 }
 
@@ -138,24 +197,19 @@ void Interpreter::operator()(const PrintStatement& stmt) {
 }
 
 void expectVoidReturnValue(const ReturnValue& valueObj) {
-    if (valueObj) {
-        const auto actualType = std::visit(ValueToType(), valueObj->value);
-        throw ReturnTypeMismatch{
-            {},
-            VoidType(),
-            std::visit([](auto t) -> ReturnType { return t; }, actualType)};
-    }
+    if (valueObj)
+        throw ReturnTypeMismatch{{}, TypeToString()(VoidType()),
+                                 std::visit(ValueToTypeName(), valueObj->value)};
 }
 
 void expectNonVoidReturnValue(const ReturnType& expected, const ReturnValue& valueObj) {
     if (!valueObj)
-        throw ReturnTypeMismatch{{}, expected, VoidType{}};
+        throw ReturnTypeMismatch{{}, std::visit(TypeToString(), expected),
+                                 TypeToString()(VoidType())};
 
-    if (!std::visit(TypeComparer(), expected, valueObj->value)) {
-        const auto actualType = std::visit(ValueToType(), valueObj->value);
-        throw ReturnTypeMismatch{
-            {}, expected, std::visit([](auto t) -> ReturnType { return t; }, actualType)};
-    }
+    if (!std::visit(TypeComparer(), expected, valueObj->value))
+        throw ReturnTypeMismatch{{}, std::visit(TypeToString(), expected),
+                                 std::visit(ValueToTypeName(), valueObj->value)};
 }
 
 void checkReturnType(const ReturnType& expected, const ReturnValue& valueObj) {
@@ -167,7 +221,8 @@ void checkReturnType(const ReturnType& expected, const ReturnValue& valueObj) {
 
 void checkValueType(const Type& type, const ValueObj& valueObj) {
     if (!std::visit(TypeComparer(), type, valueObj.value))
-        throw TypeMismatch{{}, type, std::visit(ValueToType(), valueObj.value)};
+        throw TypeMismatch{{}, std::visit(TypeToString(), type),
+                           std::visit(ValueToTypeName(), valueObj.value)};
 }
 
 bool valueTypeOtherThanExpected(const Type& expected, const ValueHolder& holder) {
@@ -177,7 +232,7 @@ bool valueTypeOtherThanExpected(const Type& expected, const ValueHolder& holder)
 
 ValueHolder Interpreter::convertAndCheckType(const Type& expected,
                                              ValueHolder holder) const {
-    auto userDefinedTypeName = std::get_if<std::string>(&expected);
+    auto userDefinedTypeName = std::get_if<Symbol>(&expected);
     if (valueTypeOtherThanExpected(expected, holder) && userDefinedTypeName) {
         auto valueObj = getHeldValue(std::move(holder));
         convertToUserDefinedType(valueObj, *userDefinedTypeName);
@@ -189,14 +244,13 @@ ValueHolder Interpreter::convertAndCheckType(const Type& expected,
     return holder;
 }
 
-void Interpreter::convertToUserDefinedType(ValueObj& valueObj,
-                                           std::string_view typeName) const {
+void Interpreter::convertToUserDefinedType(ValueObj& valueObj, Symbol typeName) const {
     if (auto structDef = getStructDef(typeName))
         convertToNamedStruct(valueObj, structDef);
     else if (auto variantDef = getVariantDef(typeName))
         convertToVariant(valueObj, variantDef);
     else
-        throw SymbolNotFound{{}, "User defined type", std::string(typeName)};
+        throw SymbolNotFound{{}, "User defined type", std::string(typeName.getName())};
 }
 
 void Interpreter::convertToNamedStruct(ValueObj& valueObj,
@@ -259,13 +313,13 @@ struct FieldAccessEvaluator {
     explicit FieldAccessEvaluator(const Interpreter& interpreter)
         : interpreter_{interpreter} {}
 
-    RefObj operator()(std::string_view name) {
+    RefObj operator()(Symbol name) {
         if (const auto refObj = interpreter_.getVariable(name))
             return *refObj;
-        throw SymbolNotFound{{}, "Variable", std::string(name)};
+        throw SymbolNotFound{{}, "Variable", std::string(name.getName())};
     }
 
-    RefObj operator()(const std::unique_ptr<FieldAccess>& fieldAccess) {
+    RefObj operator()(const ArenaPtr<FieldAccess>& fieldAccess) {
         const auto containerRef = std::visit(*this, fieldAccess->container);
         const auto namedStruct =
             std::get_if<NamedStructObj>(&containerRef.valueObj->value);
@@ -324,7 +378,8 @@ void Interpreter::operator()(const FuncCall& funcCall) {
 ReturnValue Interpreter::handleFunctionCall(const FuncCall& funcCall) {
     auto funcWithCtx = getFunctionWithCtx(funcCall.name);
     if (!funcWithCtx)
-        throw SymbolNotFound{funcCall.Statement::position, "Function", funcCall.name};
+        throw SymbolNotFound{funcCall.Statement::position, "Function",
+                             std::string(funcCall.name.getName())};
     const auto [funcDef, parentCtx] = *funcWithCtx;
 
     CallContext ctx{parentCtx};
@@ -347,7 +402,7 @@ ReturnValue Interpreter::handleFunctionCall(const FuncCall& funcCall) {
     }
     returning_ = false;
 
-    if (const auto typeName = std::get_if<std::string>(&funcDef->getReturnType()))
+    if (const auto typeName = std::get_if<Symbol>(&funcDef->getReturnType()))
         try {
             convertToUserDefinedType(*returnValue_, *typeName);
         } catch (const InvalidFieldCount& e) {
@@ -396,8 +451,7 @@ void checkArgRef(const Argument& arg, const Parameter& param) {
 }
 
 struct VariableAdder {
-    VariableAdder(CallContext& callCtx, std::string name)
-        : callCtx_{callCtx}, name_{std::move(name)} {}
+    VariableAdder(CallContext& callCtx, Symbol name) : callCtx_{callCtx}, name_{name} {}
 
     void operator()(ValueObj valueObj) const {
         VarEntry varEntry = {.name = name_,
@@ -412,7 +466,7 @@ struct VariableAdder {
 
    private:
     CallContext& callCtx_;
-    std::string name_;
+    Symbol name_;
 };
 
 bool isConst(const ValueHolder& holder) {
@@ -6,6 +6,7 @@
 
 #include "call_context.hpp"
 #include "expr_interpreter.hpp"
+#include "interpreter_errors.hpp"
 #include "parse_tree.hpp"
 
 using ReturnValue = std::optional<ValueObj>;
@@ -21,25 +22,41 @@ class Interpreter : public StatementVisitor {
     /// @param program
     void interpret(const Program& program);
 
+    /// @brief Interprets a single top-level statement. Definitions it makes are kept, so
+    /// the statement must outlive the interpreter
+    ///
+    /// After an error the interpreter is back in the global scope and can carry on with
+    /// next statements
+    /// @param stmt
+    void interpret(const Statement& stmt);
+
+    /// @brief Interprets the program (e.g. a fragment with a single statement), taking
+    /// ownership of it
+    ///
+    /// Only programs defining functions, structs or variants are kept, the rest is freed
+    /// right after running. So a program run statement by statement as it is parsed
+    /// takes little memory, unless it is mostly definitions
+    /// @param program
+    void interpret(Program&& program);
+
     /// @brief Returns a reference to a variable with the given name or std::nullopt if
     /// not found
     /// @param name
-    std::optional<RefObj> getVariable(std::string_view name) const;
+    std::optional<RefObj> getVariable(Symbol name) const;
 
     /// @brief Returns a function definition with the given name along with the scope in
     /// which the function is defined. If not found the std::nullopt is returned
     /// @param name
-    std::optional<CallContext::FuncWithCtx> getFunctionWithCtx(
-        std::string_view name) const;
+    std::optional<CallContext::FuncWithCtx> getFunctionWithCtx(Symbol name) const;
 
     /// @brief Returns a function definition with the given name or a nullptr if nout
     /// found
     /// @param name
-    const StructDef* getStructDef(std::string_view name) const;
+    const StructDef* getStructDef(Symbol name) const;
 
     /// @brief Returns a variant definition with the given name or a nullptr if nout found
     /// @param name
-    const VariantDef* getVariantDef(std::string_view name) const;
+    const VariantDef* getVariantDef(Symbol name) const;
 
     void operator()(const IfStatement& ifStmt) override;
     void operator()(const WhileStatement& whileStmt) override;
@@ -64,7 +81,7 @@ class Interpreter : public StatementVisitor {
     void addVariant(const VariantDef* variantDef);
 
     ValueHolder convertAndCheckType(const Type& expected, ValueHolder holder) const;
-    void convertToUserDefinedType(ValueObj& valueObj, std::string_view typeName) const;
+    void convertToUserDefinedType(ValueObj& valueObj, Symbol typeName) const;
 
     /// @brief Converts anonymous struct (StructObj) to one with field names (NamedStruct)
     /// @param valueObj
@@ -88,6 +105,9 @@ class Interpreter : public StatementVisitor {
 
     ValueHolder getValueFromExpr(const Expression& expr);
 
+    // Programs passed with ownership that scopes may point into
+    std::vector<Program> definitions_;
+
     std::stack<CallContext> callStack_;
     std::ostream& out_;
 
@@ -110,11 +130,10 @@ struct TypeComparer {
     bool operator()(BuiltInType variableType, const std::string&) const {
         return variableType == BuiltInType::STR;
     }
-    bool operator()(const std::string& variableType,
-                    const NamedStructObj& structObj) const {
+    bool operator()(Symbol variableType, const NamedStructObj& structObj) const {
         return structObj.structDef->name == variableType;
     }
-    bool operator()(const std::string& variableType, const VariantObj& variantObj) const {
+    bool operator()(Symbol variableType, const VariantObj& variantObj) const {
         return variantObj.variantDef->name == variableType;
     }
     bool operator()(const auto&, const auto&) const { return false; }
@@ -132,7 +151,16 @@ struct ValueToType {
     Type operator()(const VariantObj& variantObj) const {
         return variantObj.variantDef->name;
     }
-    Type operator()(const StructObj&) const { return "Anonymous struct"; }
+    // Anonymous structs have no type, the empty symbol never names a definition
+    Type operator()(const StructObj&) const { return Symbol(); }
+};
+
+/// @brief Returns the name of the type of the given value shown in error messages
+struct ValueToTypeName {
+    std::string operator()(const StructObj&) const { return "Anonymous struct"; }
+    std::string operator()(const auto& value) const {
+        return std::visit(TypeToString(), ValueToType()(value));
+    }
 };
 
 #endif
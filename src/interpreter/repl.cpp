@@ -0,0 +1,82 @@
+#include "repl.hpp"
+
+#include "lexer.hpp"
+#include "lexer_errors.hpp"
+#include "parser.hpp"
+
+Repl::Repl(std::ostream& out, std::ostream& err)
+    : out_{out}, err_{err}, interpreter_{out} {}
+
+bool Repl::feedLine(std::string_view line) {
+    // Offsets keep growing through the whole session, so errors point to the input line
+    const auto lineOffset = pendingOffset_ + static_cast<std::uint32_t>(pending_.size());
+    pending_.append(line);
+    pending_ += '\n';
+    lineIndex_.addBlock(std::string_view(pending_).substr(lineOffset - pendingOffset_),
+                        lineOffset);
+
+    runPending(false);
+    return !pending_.empty();
+}
+
+void Repl::finish() {
+    runPending(true);
+}
+
+void Repl::runPending(bool final) {
+    try {
+        runCompleteStatements(final);
+    } catch (const BaseException& e) {
+        err_ << e.describe(lineIndex_) << '\n';
+        pendingOffset_ += static_cast<std::uint32_t>(pending_.size());
+        pending_.clear();
+    }
+}
+
+void Repl::runCompleteStatements(bool final) {
+    const auto endOffset = pendingOffset_ + static_cast<std::uint32_t>(pending_.size());
+    auto consumedOffset = pendingOffset_;
+
+    try {
+        auto source = Source(pending_, pendingOffset_);
+        auto lexer = Lexer(source, Lexer::CommentMode::DISCARD);
+        auto parser = Parser(lexer);
+
+        while (true) {
+            auto fragment = parser.parseNextStatement();
+            if (fragment.statements.empty())
+                break;
+            // The statement ended, the rest of the input starts with the next token
+            consumedOffset = parser.getCurrentToken().getPosition().offset;
+            interpreter_.interpret(std::move(fragment));
+        }
+        consumedOffset = endOffset;
+    } catch (const NotTerminatedStrConst&) {
+        // The str literal may continue in the next line
+        if (final)
+            throw;
+    } catch (const SyntaxException& e) {
+        // Running out of input is not an error yet, the next line may complete the
+        // statement
+        if (final || e.getPosition().offset != endOffset)
+            throw;
+    }
+    pending_.erase(0, consumedOffset - pendingOffset_);
+    pendingOffset_ = consumedOffset;
+}
+
+void Repl::run(std::istream& in, bool prompt) {
+    std::string line;
+    bool unfinished{false};
+
+    while (true) {
+        if (prompt)
+            out_ << (unfinished ? "... " : ">>> ") << std::flush;
+        if (!std::getline(in, line))
+            break;
+        unfinished = feedLine(line);
+    }
+    if (prompt)
+        out_ << '\n';
+    finish();
+}
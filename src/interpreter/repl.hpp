@@ -0,0 +1,55 @@
+#ifndef REPL_H
+#define REPL_H
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "interpreter.hpp"
+#include "line_index.hpp"
+
+/// @brief Interactive session running statements as soon as their input arrives
+///
+/// Input is fed line by line. Every top-level statement completed by a line is parsed
+/// and run right away by a single interpreter, so definitions carry over to the next
+/// lines. Only the text of the unfinished statement is kept for parsing, so the time
+/// spent on a line does not depend on how much input came before it
+class Repl {
+   public:
+    /// @param out the stream to which the output of the statements will be written
+    /// @param err the stream to which errors will be reported
+    Repl(std::ostream& out, std::ostream& err);
+
+    /// @brief Runs the statements completed by the line
+    ///
+    /// An error is reported and the rest of the unfinished input is dropped
+    /// @param line without the new line character
+    /// @return True if the input ends with an unfinished statement waiting for more lines
+    bool feedLine(std::string_view line);
+
+    /// @brief Ends the input, reporting the unfinished statement if there is one
+    void finish();
+
+    /// @brief Feeds lines read from the stream until it ends
+    /// @param in
+    /// @param prompt whether to write a prompt before every line (e.g. for a terminal)
+    void run(std::istream& in, bool prompt);
+
+   private:
+    /// @brief Parses and runs the complete statements of the pending input, removing
+    /// their text from it. Reports an error and drops the whole input on failure
+    /// @param final whether the input has ended, so an unfinished statement is an error
+    void runPending(bool final);
+    void runCompleteStatements(bool final);
+
+    std::ostream& out_;
+    std::ostream& err_;
+    Interpreter interpreter_;
+
+    std::string pending_;
+    std::uint32_t pendingOffset_{0};
+    LineIndex lineIndex_;
+};
+
+#endif
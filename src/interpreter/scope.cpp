@@ -1,53 +1,50 @@
 #include "scope.hpp"
 
-#include <algorithm>
-
 #include "interpreter_errors.hpp"
 
+/// @brief Returns the value stored under the name or nullptr if there is none
+template <typename Map>
+const Map::mapped_type* find(const Map& map, Symbol name) {
+    const auto it = map.find(name);
+    return it != map.end() ? &it->second : nullptr;
+}
+
 void Scope::addVariable(VarEntry entry) {
-    if (getVariable(entry.name))
-        throw VariableRedefinition{{}, entry.name};
-    variables_.push_back(std::move(entry));
+    const auto name = entry.name;
+    if (!variables_.try_emplace(name, std::move(entry)).second)
+        throw VariableRedefinition{{}, std::string(name.getName())};
 }
 
 void Scope::addFunction(const FuncDef* func) {
-    if (getFunction(func->getName()))
-        throw FunctionRedefinition{{}, func->getName()};
-    functions_.emplace_back(func);
+    if (!functions_.try_emplace(func->getName(), func).second)
+        throw FunctionRedefinition{{}, std::string(func->getName().getName())};
 }
 
 void Scope::addStruct(const StructDef* structDef) {
-    structs_.emplace_back(structDef);
+    structs_.try_emplace(structDef->name, structDef);
 }
 
 void Scope::addVariant(const VariantDef* variantDef) {
-    variants_.emplace_back(variantDef);
+    variants_.try_emplace(variantDef->name, variantDef);
 }
 
-std::optional<RefObj> Scope::getVariable(std::string_view name) const {
-    auto res = std::ranges::find(variables_, name, &VarEntry::name);
-    if (res != variables_.end())
-        return RefObj{.valueObj = res->valueObj.get(), .isConst = res->isConst};
+std::optional<RefObj> Scope::getVariable(Symbol name) const {
+    if (const auto entry = find(variables_, name))
+        return RefObj{.valueObj = entry->valueObj.get(), .isConst = entry->isConst};
     return std::nullopt;
 }
 
-const FuncDef* Scope::getFunction(std::string_view name) const {
-    auto res = std::ranges::find(functions_, name, &FuncDef::getName);
-    if (res != functions_.end())
-        return *res;
-    return nullptr;
+const FuncDef* Scope::getFunction(Symbol name) const {
+    const auto func = find(functions_, name);
+    return func ? *func : nullptr;
 }
 
-Scope::StructDefEntry Scope::getStructDef(std::string_view name) const {
-    auto res = std::ranges::find(structs_, name, &StructDef::name);
-    if (res != structs_.end())
-        return *res;
-    return nullptr;
+Scope::StructDefEntry Scope::getStructDef(Symbol name) const {
+    const auto structDef = find(structs_, name);
+    return structDef ? *structDef : nullptr;
 }
 
-Scope::VariantDefEntry Scope::getVariantDef(std::string_view name) const {
-    auto res = std::ranges::find(variants_, name, &VariantDef::name);
-    if (res != variants_.end())
-        return *res;
-    return nullptr;
+Scope::VariantDefEntry Scope::getVariantDef(Symbol name) const {
+    const auto variantDef = find(variants_, name);
+    return variantDef ? *variantDef : nullptr;
 }
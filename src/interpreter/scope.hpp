@@ -4,14 +4,14 @@
 #include <memory>
 #include <optional>
 #include <string>
-#include <vector>
+#include <unordered_map>
 
 #include "parse_tree.hpp"
 #include "types.hpp"
 #include "value_obj.hpp"
 
 struct VarEntry {
-    std::string name;
+    Symbol name;
     std::unique_ptr<ValueObj> valueObj;
     bool isConst{false};
 };
@@ -27,16 +27,18 @@ class Scope {
     void addStruct(const StructDef* structDef);
     void addVariant(const VariantDef* variantDef);
 
-    std::optional<RefObj> getVariable(std::string_view name) const;
-    const FuncDef* getFunction(std::string_view name) const;
-    StructDefEntry getStructDef(std::string_view name) const;
-    VariantDefEntry getVariantDef(std::string_view name) const;
+    std::optional<RefObj> getVariable(Symbol name) const;
+    const FuncDef* getFunction(Symbol name) const;
+    StructDefEntry getStructDef(Symbol name) const;
+    VariantDefEntry getVariantDef(Symbol name) const;
 
    private:
-    std::vector<VarEntry> variables_;
-    std::vector<FuncDefEntry> functions_;
-    std::vector<StructDefEntry> structs_;
-    std::vector<VariantDefEntry> variants_;
+    // Hashed by name, so lookups do not slow down as definitions pile up (e.g. in the
+    // global scope of a long interactive session)
+    std::unordered_map<Symbol, VarEntry> variables_;
+    std::unordered_map<Symbol, FuncDefEntry> functions_;
+    std::unordered_map<Symbol, StructDefEntry> structs_;
+    std::unordered_map<Symbol, VariantDefEntry> variants_;
 };
 
 #endif
@@ -11,10 +11,10 @@ NamedStructObj::NamedStructObj(Values values, const StructDef* structDef)
             "Cannot instantiate StructObj without struct definition");
 }
 
-ValueObj* NamedStructObj::getField(std::string_view fieldName) const {
+ValueObj* NamedStructObj::getField(Symbol fieldName) const {
     const auto field = std::ranges::find(structDef->fields, fieldName, &Field::name);
     if (field == structDef->fields.end())
-        throw InvalidField{{}, fieldName};
+        throw InvalidField{{}, fieldName.getName()};
     const auto index = std::ranges::distance(structDef->fields.begin(), field);
     return values.at(index).get();
 }
@@ -19,7 +19,7 @@ struct StructObj {
 /// @brief Struct with field names
 struct NamedStructObj : public StructObj {
     NamedStructObj(Values values, const StructDef* structDef);
-    ValueObj* getField(std::string_view fieldName) const;
+    ValueObj* getField(Symbol fieldName) const;
 
     const StructDef* structDef;
 };
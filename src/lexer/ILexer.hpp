@@ -1,11 +1,35 @@
 #ifndef I_LEXER_H
 #define I_LEXER_H
 
+#include <span>
+#include <string>
+
 #include "token.hpp"
 
 class ILexer {
    public:
     virtual Token getToken() = 0;
+
+    /// @brief Writes subsequent tokens into the buffer. Saves a virtual call per token
+    ///
+    /// The end-of-text token is always the last one written. If an exception occurs
+    /// after some tokens were written, these are returned and the exception is thrown
+    /// by the next call. Fewer tokens than fit may be written when getting more would
+    /// wait for input
+    /// @param tokens non-empty buffer
+    /// @return Number of tokens written, at least one
+    virtual std::size_t getTokens(std::span<Token> tokens) = 0;
+
+    /// @brief Returns text of the token: name of an identifier, value of a str literal or
+    /// content of a comment
+    ///
+    /// Str literals and comments keep only a handle to their text, which the lexer that
+    /// built them resolves. Safe to call while the lexer produces tokens on another
+    /// thread
+    /// @param token returned by this lexer
+    /// @return Text of the token or empty string if the token has no text
+    virtual std::string getText(const Token& token) const = 0;
+
     virtual ~ILexer() = default;
 };
 
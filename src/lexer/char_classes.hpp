@@ -0,0 +1,57 @@
+#ifndef CHAR_CLASSES_H
+#define CHAR_CLASSES_H
+
+#include <array>
+#include <cstdint>
+
+/// Character classes used by the lexer. Looked up in a table, unlike std::isalpha and
+/// friends that depend on the locale and are undefined for negative chars.
+///
+/// Every byte of a multibyte UTF-8 sequence is a letter, so identifiers can contain
+/// non-ASCII characters. The source is validated as UTF-8 beforehand, so such bytes
+/// always form whole characters
+
+enum CharClass : std::uint8_t {
+    LETTER = 1 << 0,
+    DIGIT = 1 << 1,
+    UNDERSCORE = 1 << 2,
+    WHITE_SPACE = 1 << 3,
+};
+
+constexpr std::array<std::uint8_t, 256> charClasses = [] {
+    std::array<std::uint8_t, 256> classes{};
+    for (int c{'a'}; c <= 'z'; ++c)
+        classes[c] |= LETTER;
+    for (int c{'A'}; c <= 'Z'; ++c)
+        classes[c] |= LETTER;
+    for (int c{0x80}; c <= 0xFF; ++c)
+        classes[c] |= LETTER;
+    for (int c{'0'}; c <= '9'; ++c)
+        classes[c] |= DIGIT;
+    classes['_'] |= UNDERSCORE;
+    for (const char c : {' ', '\t', '\n', '\v', '\f', '\r'})
+        classes[static_cast<unsigned char>(c)] |= WHITE_SPACE;
+    return classes;
+}();
+
+inline bool hasClass(char c, std::uint8_t charClass) {
+    return charClasses[static_cast<unsigned char>(c)] & charClass;
+}
+
+inline bool isLetter(char c) {
+    return hasClass(c, LETTER);
+}
+
+inline bool isDigit(char c) {
+    return hasClass(c, DIGIT);
+}
+
+inline bool isIdentifierChar(char c) {
+    return hasClass(c, LETTER | DIGIT | UNDERSCORE);
+}
+
+inline bool isWhiteSpace(char c) {
+    return hasClass(c, WHITE_SPACE);
+}
+
+#endif
@@ -1,6 +1,9 @@
 #ifndef FILTER_H
 #define FILTER_H
 
+#include <algorithm>
+#include <cstdint>
+
 #include "ILexer.hpp"
 
 /// @brief Exception thrown when trying to instantiate
@@ -40,9 +43,95 @@ class Filter : public ILexer {
         return token;
     }
 
+    /// @brief Writes a batch of tokens from the decorated ILexer into the buffer, leaving
+    /// out the ones of the ignored type. Requests another batch if all of them were
+    /// ignored
+    /// @param tokens non-empty buffer
+    /// @return Number of tokens written, at least one
+    std::size_t getTokens(std::span<Token> tokens) override {
+        std::size_t count{0};
+
+        while (count == 0) {
+            const auto batch = tokens.first(lexer_.getTokens(tokens));
+            const auto ignored = std::ranges::remove(batch, ignore_, &Token::getType);
+            count = batch.size() - ignored.size();
+        }
+
+        return count;
+    }
+
+    std::string getText(const Token& token) const override {
+        return lexer_.getText(token);
+    }
+
    private:
     ILexer& lexer_;
     Token::Type ignore_;
 };
 
+/// @brief Filter ignoring the given token types, known at compile time. Implements the
+/// same interface as Lexer.
+///
+/// Unlike Filter it knows the type of the decorated lexer, so calls to it are not
+/// virtual (given LexerT is final) and can be inlined. Checking whether a token is
+/// ignored is a single bit test, regardless of how many types are ignored
+/// @tparam LexerT type of the decorated lexer
+/// @tparam Ignored types of ignored tokens
+template <typename LexerT, Token::Type... Ignored>
+class BasicFilter final : public ILexer {
+    static_assert(((Ignored != Token::Type::ETX) && ...),
+                  "Cannot specify ETX as ignore type");
+    static_assert(((static_cast<unsigned int>(Ignored) < 64) && ...),
+                  "Token type does not fit into the mask");
+
+    static constexpr std::uint64_t ignoredMask_{
+        (std::uint64_t{0} | ...
+         | (std::uint64_t{1} << static_cast<unsigned int>(Ignored)))};
+
+    static constexpr bool isIgnored(const Token& token) {
+        return (ignoredMask_ >> static_cast<unsigned int>(token.getType())) & 1;
+    }
+
+   public:
+    /// @brief Constructs filter that decorates lexer
+    /// @param lexer
+    explicit BasicFilter(LexerT& lexer) : lexer_(lexer) {}
+
+    /// @brief Returns a token from the decorated lexer. Requests another token until the
+    /// token returned is not of an ignored type
+    /// @return Token from decorated lexer of type other than the ignored ones
+    Token getToken() override {
+        Token token;
+
+        do {
+            token = lexer_.getToken();
+        } while (isIgnored(token));
+
+        return token;
+    }
+
+    /// @brief Writes a batch of tokens from the decorated lexer into the buffer, leaving
+    /// out the ones of ignored types. Requests another batch if all of them were ignored
+    /// @param tokens non-empty buffer
+    /// @return Number of tokens written, at least one
+    std::size_t getTokens(std::span<Token> tokens) override {
+        std::size_t count{0};
+
+        while (count == 0) {
+            const auto batch = tokens.first(lexer_.getTokens(tokens));
+            const auto ignored = std::ranges::remove_if(batch, isIgnored);
+            count = batch.size() - ignored.size();
+        }
+
+        return count;
+    }
+
+    std::string getText(const Token& token) const override {
+        return lexer_.getText(token);
+    }
+
+   private:
+    LexerT& lexer_;
+};
+
 #endif
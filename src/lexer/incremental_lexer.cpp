@@ -0,0 +1,101 @@
+#include "incremental_lexer.hpp"
+
+#include <algorithm>
+
+#include "lexer_errors.hpp"
+#include "scanner.hpp"
+
+void validateEdit(std::string_view text, std::size_t editBegin, std::size_t editEnd);
+
+TokenRange relex(std::string_view text, const Edit& edit, std::vector<Token>& tokens,
+                 Lexer::CommentMode commentMode) {
+    const auto insertedLength = static_cast<std::uint32_t>(edit.insertedText.size());
+    const auto editEnd = edit.offset + insertedLength;
+    const auto shift = static_cast<std::int64_t>(insertedLength) - edit.removedLength;
+
+    // The source is not validated up front, the rest of the text was valid before
+    validateEdit(text, edit.offset, editEnd);
+
+    auto startsBefore = [](const Token& token, std::uint32_t offset) {
+        return token.getPosition().offset < offset;
+    };
+
+    // The token just before the edit may be extended by it (e.g. an identifier), the
+    // ones before it are not affected
+    const auto firstAfter =
+        std::lower_bound(tokens.begin(), tokens.end(), edit.offset, startsBefore);
+    const auto first = firstAfter == tokens.begin() ? firstAfter : firstAfter - 1;
+    const auto startOffset = first == tokens.begin() ? 0 : first->getPosition().offset;
+
+    auto source = Source(text.substr(startOffset), startOffset, false);
+    auto lexer = Lexer(source, commentMode);
+
+    std::vector<Token> relexed;
+    auto resync = first;
+
+    while (true) {
+        const auto token = lexer.getToken();
+        const auto offset = token.getPosition().offset;
+
+        // Past the edit the text is the same as before. A token starting where one of
+        // the previous tokens started is followed by the same tokens
+        if (offset >= editEnd) {
+            const auto previousOffset = static_cast<std::uint32_t>(offset - shift);
+            resync = std::lower_bound(resync, tokens.end(), previousOffset, startsBefore);
+            if (resync != tokens.end() && resync->getPosition().offset == previousOffset)
+                break;
+        }
+
+        relexed.push_back(token);
+        if (token.getType() == Token::Type::ETX) {
+            resync = tokens.end();
+            break;
+        }
+    }
+
+    for (auto it = resync; it != tokens.end(); ++it) {
+        const auto offset = static_cast<std::uint32_t>(it->getPosition().offset + shift);
+        it->setPosition({offset});
+    }
+
+    const TokenRange range{.begin = static_cast<std::size_t>(first - tokens.begin()),
+                           .removed = static_cast<std::size_t>(resync - first),
+                           .inserted = relexed.size()};
+
+    // Typical edits keep the number of tokens, then there is nothing to move
+    if (range.removed == range.inserted) {
+        std::ranges::copy(relexed, first);
+        return range;
+    }
+
+    const auto replaced = tokens.erase(first, resync);
+    tokens.insert(replaced, relexed.begin(), relexed.end());
+    return range;
+}
+
+/// @brief Throws InvalidUtf8 if the edited characters together with the multibyte
+/// characters they touch are not valid UTF-8
+void validateEdit(std::string_view text, std::size_t editBegin, std::size_t editEnd) {
+    constexpr std::size_t maxContinuationBytes{3};
+    auto isContinuationByte = [&](std::size_t offset) {
+        return (static_cast<unsigned char>(text[offset]) & 0xc0) == 0x80;
+    };
+
+    // Characters starting earlier end before the edit and were valid before it
+    const auto editStart = std::min(editBegin, text.size());
+    auto begin = editStart - std::min(editStart, maxContinuationBytes);
+    while (begin < editStart && isContinuationByte(begin))
+        ++begin;
+
+    auto end = std::min(editEnd, text.size());
+    const auto endLimit = std::min(end + maxContinuationBytes, text.size());
+    while (end < endLimit && isContinuationByte(end))
+        ++end;
+
+    const auto window = text.substr(begin, end - begin);
+    const auto invalid = findInvalidUtf8(window.data(), window.data() + window.size());
+    if (invalid != window.data() + window.size()) {
+        const auto offset = begin + static_cast<std::size_t>(invalid - window.data());
+        throw InvalidUtf8({static_cast<std::uint32_t>(offset)});
+    }
+}
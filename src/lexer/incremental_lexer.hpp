@@ -0,0 +1,44 @@
+#ifndef INCREMENTAL_LEXER_H
+#define INCREMENTAL_LEXER_H
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "lexer.hpp"
+
+/// @brief Change of a text: removedLength characters at the offset were replaced with
+/// the inserted text
+struct Edit {
+    std::uint32_t offset{0};
+    std::uint32_t removedLength{0};
+    std::string_view insertedText;
+};
+
+/// @brief Range of tokens replaced by relex()
+struct TokenRange {
+    std::size_t begin{0};     ///< Index of the first replaced token
+    std::size_t removed{0};   ///< Number of previous tokens removed
+    std::size_t inserted{0};  ///< Number of tokens inserted in their place
+};
+
+/// @brief Updates tokens of a text after the text was edited
+///
+/// Lexing starts from the last token before the edit and stops as soon as a token starts
+/// where one of the previous tokens started in the unchanged rest of the text. From there
+/// on the tokens are the same, only shifted. So the work grows with the size of the edit,
+/// not of the text (apart from shifting the positions of the following tokens)
+///
+/// If the edited text cannot be lexed (including the inserted text not being valid
+/// UTF-8), the exception is thrown and the tokens are left unchanged
+/// @param text whole text, with the edit already applied
+/// @param edit applied to the text
+/// @param tokens of the text before the edit, ending with ETX, lexed in zero-copy mode.
+/// Replaced by tokens of the edited text. Text of str literals and comments is found in
+/// the text by Lexer::getText()
+/// @param commentMode the tokens were lexed with
+/// @return Range of the tokens that changed
+TokenRange relex(std::string_view text, const Edit& edit, std::vector<Token>& tokens,
+                 Lexer::CommentMode commentMode = Lexer::CommentMode::KEEP);
+
+#endif
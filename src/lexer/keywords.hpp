@@ -0,0 +1,90 @@
+#ifndef KEYWORDS_H
+#define KEYWORDS_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <ranges>
+#include <string_view>
+#include <utility>
+
+#include "token.hpp"
+
+/// @brief Keyword together with the type of its token
+struct Keyword {
+    std::string_view lexeme;
+    Token::Type type{Token::Type::UNKNOWN};
+};
+
+inline constexpr std::array keywords{
+    Keyword{"if", Token::Type::IF_KW},
+    Keyword{"while", Token::Type::WHILE_KW},
+    Keyword{"return", Token::Type::RETURN_KW},
+    Keyword{"print", Token::Type::PRINT_KW},
+    Keyword{"const", Token::Type::CONST_KW},
+    Keyword{"ref", Token::Type::REF_KW},
+    Keyword{"struct", Token::Type::STRUCT_KW},
+    Keyword{"variant", Token::Type::VARIANT_KW},
+    Keyword{"or", Token::Type::OR_KW},
+    Keyword{"and", Token::Type::AND_KW},
+    Keyword{"not", Token::Type::NOT_KW},
+    Keyword{"as", Token::Type::AS_KW},
+    Keyword{"is", Token::Type::IS_KW},
+    Keyword{"void", Token::Type::VOID_KW},
+    Keyword{"int", Token::Type::INT_KW},
+    Keyword{"float", Token::Type::FLOAT_KW},
+    Keyword{"bool", Token::Type::BOOL_KW},
+    Keyword{"str", Token::Type::STR_KW},
+};
+
+inline constexpr std::size_t keywordTableSize{32};
+
+/// @brief Hash of a non-empty lexeme built from its first and last character and length
+constexpr std::size_t keywordHash(std::string_view lexeme, std::uint32_t seed) {
+    const std::uint32_t first = static_cast<unsigned char>(lexeme.front());
+    const std::uint32_t last = static_cast<unsigned char>(lexeme.back());
+    const auto length = static_cast<std::uint32_t>(lexeme.size());
+    return (((first ^ last << 2 ^ length << 4) * seed) >> 8) % keywordTableSize;
+}
+
+/// @brief Finds the smallest seed for which no two keywords share a hash
+constexpr std::uint32_t findKeywordSeed() {
+    for (std::uint32_t seed{1}; seed != 0; ++seed) {
+        std::array<bool, keywordTableSize> taken{};
+        const bool collision = std::ranges::any_of(keywords, [&](const Keyword& keyword) {
+            return std::exchange(taken[keywordHash(keyword.lexeme, seed)], true);
+        });
+        if (!collision)
+            return seed;
+    }
+    return 0;
+}
+
+inline constexpr std::uint32_t keywordSeed{findKeywordSeed()};
+static_assert(keywordSeed != 0, "No perfect hash for keywords");
+
+inline constexpr auto keywordTable = [] {
+    std::array<Keyword, keywordTableSize> table{};
+    for (const auto& keyword : keywords)
+        table[keywordHash(keyword.lexeme, keywordSeed)] = keyword;
+    return table;
+}();
+
+inline constexpr auto keywordLengths = std::ranges::minmax(
+    keywords | std::views::transform([](const Keyword& k) { return k.lexeme.size(); }));
+
+/// @brief Returns the token type of the keyword using one hash and one comparison
+/// @param lexeme
+/// @return Type of the keyword or std::nullopt if lexeme is not a keyword
+constexpr std::optional<Token::Type> findKeyword(std::string_view lexeme) {
+    if (lexeme.size() < keywordLengths.min || lexeme.size() > keywordLengths.max)
+        return std::nullopt;
+
+    const auto& keyword = keywordTable[keywordHash(lexeme, keywordSeed)];
+    if (keyword.lexeme == lexeme)
+        return keyword.type;
+    return std::nullopt;
+}
+
+#endif
@@ -1,88 +1,151 @@
 #include "lexer.hpp"
 
 #include <algorithm>
-#include <cmath>
+#include <charconv>
 #include <limits>
 #include <string_view>
+#include <utility>
 
+#include "char_classes.hpp"
+#include "keywords.hpp"
 #include "lexer_errors.hpp"
-#include "magic_enum/magic_enum.hpp"
+#include "scanner.hpp"
 
-bool isAlnumOrUnderscore(char c);
-bool isAnyUpperCase(std::string_view s);
+const char* skipIdentifierChars(const char* begin, const char* end);
+const char* skipDigits(const char* begin, const char* end);
+[[noreturn]] void throwNumericOverflow(const Position& position, std::string_view digits);
 Integral charToDigit(char c);
 bool willOverflow(Integral value, Integral digit);
-std::string lexemeToKeyword(std::string_view lexeme);
+bool hasTextHandle(const Token& token);
+Position getContentPosition(const Token& token);
+
+/// @brief Number of digits of the maximal Integral
+constexpr std::size_t maxIntegralDigits{std::numeric_limits<Integral>::digits10 + 1};
 
 Token Lexer::getToken() {
+    if (pendingError_)
+        std::rethrow_exception(std::exchange(pendingError_, nullptr));
+    return buildToken();
+}
+
+std::size_t Lexer::getTokens(std::span<Token> tokens) {
+    if (pendingError_)
+        std::rethrow_exception(std::exchange(pendingError_, nullptr));
+
+    std::size_t count{0};
+    try {
+        while (count < tokens.size()) {
+            tokens[count] = buildToken();
+            if (tokens[count++].getType() == Token::Type::ETX)
+                break;
+            // Hand out the tokens lexed so far instead of waiting for more input
+            if (source_.isDrained())
+                break;
+        }
+    } catch (...) {
+        if (count == 0)
+            throw;
+        pendingError_ = std::current_exception();
+    }
+    return count;
+}
+
+Token Lexer::buildToken() {
     ignoreWhiteSpace();
 
     tokenPosition_ = source_.getPosition();
 
-    for (const auto& builder : tokenBuilders_) {
-        if (auto token = builder(*this))
-            return token.value();
+    // The first character determines which token is being built
+    const auto c = source_.getChar();
+    switch (c) {
+        case EOF:
+            if (source_.hasInvalidUtf8())
+                throw InvalidUtf8(source_.getPosition());
+            return buildOneLetterOp(Token::Type::ETX);
+        case '"':
+            return buildStrConst();
+        case '#':
+            return buildComment();
+        case '!':
+            return buildNotEqualOp();
+        case ';':
+            return buildOneLetterOp(Token::Type::SEMI);
+        case ',':
+            return buildOneLetterOp(Token::Type::CMA);
+        case '.':
+            return buildOneLetterOp(Token::Type::DOT);
+        case '+':
+            return buildOneLetterOp(Token::Type::ADD_OP);
+        case '-':
+            return buildOneLetterOp(Token::Type::MIN_OP);
+        case '*':
+            return buildOneLetterOp(Token::Type::MULT_OP);
+        case '/':
+            return buildOneLetterOp(Token::Type::DIV_OP);
+        case '(':
+            return buildOneLetterOp(Token::Type::L_PAR);
+        case ')':
+            return buildOneLetterOp(Token::Type::R_PAR);
+        case '{':
+            return buildOneLetterOp(Token::Type::L_C_BR);
+        case '}':
+            return buildOneLetterOp(Token::Type::R_C_BR);
+        case '<':
+            return buildTwoLetterOp('=', {Token::Type::LT_OP, Token::Type::LTE_OP});
+        case '>':
+            return buildTwoLetterOp('=', {Token::Type::GT_OP, Token::Type::GTE_OP});
+        case '=':
+            return buildTwoLetterOp('=', {Token::Type::ASGN_OP, Token::Type::EQ_OP});
+        default:
+            break;
     }
 
-    throw InvalidToken(tokenPosition_, source_.getChar());
+    if (isLetter(c))
+        return buildIdOrKeyword();
+    if (isDigit(c))
+        return buildIntConst();
+
+    throw InvalidToken(tokenPosition_, c);
 }
 
 void Lexer::ignoreWhiteSpace() const {
-    while (std::isspace(source_.getChar())) {
+    // Tokens are mostly separated by no or single whitespace, not worth a bulk scan
+    if (isWhiteSpace(source_.getChar())) {
         source_.nextChar();
+        source_.skip(skipWhiteSpace);
     }
-}
 
-std::optional<Token> Lexer::buildIdOrKeyword() const {
-    if (!std::isalpha(source_.getChar()))
-        return std::nullopt;
+    while (discardComments_ && source_.getChar() == '#') {
+        source_.skip(findLineEnd);
+        source_.skip(skipWhiteSpace);
+    }
+}
 
-    std::string lexeme;
+Token Lexer::buildIdOrKeyword() const {
+    lexeme_.clear();
+    source_.skip(skipIdentifierChars, zeroCopy_ ? nullptr : &lexeme_);
 
-    do {
-        lexeme.push_back(source_.getChar());
-        source_.nextChar();
-    } while (isAlnumOrUnderscore(source_.getChar()));
+    const std::string_view lexeme = zeroCopy_ ? source_.getView(tokenPosition_) : lexeme_;
 
     if (auto token = buildKeyword(lexeme))
-        return token;
+        return *token;
 
     if (auto token = buildBoolConst(lexeme))
-        return token;
+        return *token;
 
-    return Token(Token::Type::ID, std::move(lexeme), tokenPosition_);
+    return Token(Token::Type::ID, Symbol(lexeme), tokenPosition_);
 }
 
-bool isAlnumOrUnderscore(char c) {
-    return std::isalnum(c) || c == '_';
+const char* skipIdentifierChars(const char* begin, const char* end) {
+    return std::find_if_not(begin, end, isIdentifierChar);
 }
 
 std::optional<Token> Lexer::buildKeyword(std::string_view lexeme) const {
-    if (isAnyUpperCase(lexeme))
-        return std::nullopt;
-
-    auto keyword = lexemeToKeyword(lexeme);
-
-    if (auto tokenType = magic_enum::enum_cast<Token::Type>(keyword))
+    if (auto tokenType = findKeyword(lexeme))
         return Token(tokenType.value(), {}, tokenPosition_);
     return std::nullopt;
 }
 
-bool isAnyUpperCase(std::string_view s) {
-    return std::any_of(s.begin(), s.end(), [](char c) { return std::isupper(c); });
-}
-
-std::string lexemeToKeyword(std::string_view lexeme) {
-    static const std::string_view suffix{"_KW"};
-
-    std::string keyword(lexeme.size(), ' ');
-    std::transform(lexeme.begin(), lexeme.end(), keyword.begin(),
-                   [](char c) { return std::toupper(c); });
-    keyword += suffix;
-
-    return keyword;
-}
-
 std::optional<Token> Lexer::buildBoolConst(std::string_view lexeme) const {
     if (lexeme == "true")
         return Token(Token::Type::TRUE_CONST, true, tokenPosition_);
@@ -91,62 +154,82 @@ std::optional<Token> Lexer::buildBoolConst(std::string_view lexeme) const {
     return std::nullopt;
 }
 
-std::optional<Token> Lexer::buildIntConst() const {
-    if (source_.getChar() == '0') {
-        source_.nextChar();
-
-        if (auto token = buildFloatConst(0))
-            return token;
-
-        return Token(Token::Type::INT_CONST, 0, tokenPosition_);
-    }
+Token Lexer::buildIntConst() const {
+    lexeme_.clear();
 
-    if (auto res = buildNumber()) {
-        const auto& [integralPart, _] = res.value();
+    // Leading zero is a number on its own
+    if (source_.getChar() == '0')
+        appendAndNextChar();
+    else
+        source_.skip(skipDigits, zeroCopy_ ? nullptr : &lexeme_);
 
-        if (auto token = buildFloatConst(integralPart))
-            return token;
+    if (source_.getChar() == '.')
+        return buildFloatConst();
 
-        return Token(Token::Type::INT_CONST, integralPart, tokenPosition_);
-    }
+    const auto value = parseIntegral(getLexeme());
+    return Token(Token::Type::INT_CONST, value, tokenPosition_);
+}
 
-    return std::nullopt;
+Token Lexer::buildFloatConst() const {
+    const auto integralLength = getLexeme().size();
+    appendAndNextChar();
+    source_.skip(skipDigits, zeroCopy_ ? nullptr : &lexeme_);
+
+    const auto lexeme = getLexeme();
+    const auto fractionalPart = lexeme.substr(integralLength + 1);
+    if (fractionalPart.empty())
+        throw InvalidFloat(tokenPosition_);
+
+    // Both parts are limited just like integers. Shorter ones always fit
+    if (integralLength >= maxIntegralDigits)
+        parseIntegral(lexeme.substr(0, integralLength));
+    if (fractionalPart.size() >= maxIntegralDigits)
+        parseIntegral(fractionalPart);
+
+    // Parsing the whole literal at once rounds it correctly
+    Floating value{0};
+    const auto result =
+        std::from_chars(lexeme.data(), lexeme.data() + lexeme.size(), value);
+    // With both parts in range only a fraction too small for Floating is left, it
+    // rounds to zero
+    if (result.ec == std::errc::result_out_of_range)
+        value = 0;
+    return Token(Token::Type::FLOAT_CONST, value, tokenPosition_);
 }
 
-std::optional<Token> Lexer::buildFloatConst(Integral integralPart) const {
-    if (source_.getChar() != '.')
-        return std::nullopt;
+Integral Lexer::parseIntegral(std::string_view digits) const {
+    Integral value{0};
+    const auto result =
+        std::from_chars(digits.data(), digits.data() + digits.size(), value);
+    if (result.ec == std::errc::result_out_of_range)
+        throwNumericOverflow(tokenPosition_, digits);
+    return value;
+}
 
+void Lexer::appendAndNextChar() const {
+    if (!zeroCopy_)
+        lexeme_.push_back(source_.getChar());
     source_.nextChar();
+}
 
-    if (auto res = buildNumber()) {
-        const auto& [fractionalPart, digitCount] = res.value();
-        const int exponent{-static_cast<int>(digitCount)};
-
-        const Floating value = integralPart + fractionalPart * std::pow(10, exponent);
-        return Token(Token::Type::FLOAT_CONST, value, tokenPosition_);
-    }
-
-    throw InvalidFloat(tokenPosition_);
+std::string_view Lexer::getLexeme() const {
+    return zeroCopy_ ? source_.getView(tokenPosition_) : std::string_view(lexeme_);
 }
 
-std::optional<Lexer::IntWithDigitCount> Lexer::buildNumber() const {
-    if (!std::isdigit(source_.getChar()))
-        return std::nullopt;
+const char* skipDigits(const char* begin, const char* end) {
+    return std::find_if_not(begin, end, isDigit);
+}
 
+void throwNumericOverflow(const Position& position, std::string_view digits) {
+    // Repeats the accumulation digit by digit only to report where it overflows
     Integral value{0};
-    unsigned int digitCount{0};
-
-    do {
-        auto digit = charToDigit(source_.getChar());
+    for (const char c : digits) {
+        const auto digit = charToDigit(c);
         if (willOverflow(value, digit))
-            throw NumericOverflow(tokenPosition_, value, digit);
+            throw NumericOverflow(position, value, digit);
         value = 10 * value + digit;
-        source_.nextChar();
-        ++digitCount;
-    } while (std::isdigit(source_.getChar()));
-
-    return {{value, digitCount}};
+    }
+    std::unreachable();
 }
 
 Integral charToDigit(char c) {
@@ -159,34 +242,47 @@ bool willOverflow(Integral value, Integral digit) {
     return value > maxSafe;
 }
 
-std::optional<Token> Lexer::buildStrConst() const {
-    if (source_.getChar() != '"')
-        return std::nullopt;
+Token Lexer::buildStrConst() const {
     source_.nextChar();
-
-    std::string strConst;
-
-    while (source_.getChar() != '"') {
+    const auto contentPosition = source_.getPosition();
+
+    // Spans without escape sequences are skipped in bulk. In zero-copy mode the text
+    // stays in the source and escape sequences are only validated, getText() decodes
+    // them. Otherwise the text is decoded into the lexeme
+    lexeme_.clear();
+    auto* const decoded = zeroCopy_ ? nullptr : &lexeme_;
+
+    while (true) {
+        source_.skip(findQuoteOrBackslash, decoded);
+        if (source_.getChar() == '"')
+            break;
         expectNoEndOfFile();
-        auto strConstChar = source_.getChar();
-
-        if (source_.getChar() == '\\') {
-            source_.nextChar();
-            expectNoEndOfFile();
-            strConstChar = findInEscapedChars(source_.getChar());
-        }
 
-        strConst.push_back(strConstChar);
+        source_.nextChar();
+        expectNoEndOfFile();
+        const auto escaped = findInEscapedChars(source_.getChar());
+        if (decoded)
+            decoded->push_back(escaped);
         source_.nextChar();
     }
 
+    const auto text = storeText(contentPosition);
     source_.nextChar();
-    return Token(Token::Type::STR_CONST, std::move(strConst), tokenPosition_);
+    return Token::withText(Token::Type::STR_CONST, text, tokenPosition_);
+}
+
+std::uint32_t Lexer::storeText(Position contentPosition) const {
+    if (zeroCopy_)
+        return source_.getPosition().offset - contentPosition.offset;
+    return texts_.add(lexeme_);
 }
 
 void Lexer::expectNoEndOfFile() const {
-    if (source_.getChar() == EOF)
-        throw NotTerminatedStrConst(tokenPosition_);
+    if (source_.getChar() != EOF)
+        return;
+    if (source_.hasInvalidUtf8())
+        throw InvalidUtf8(source_.getPosition());
+    throw NotTerminatedStrConst(tokenPosition_);
 }
 
 char Lexer::findInEscapedChars(char searched) const {
@@ -197,24 +293,60 @@ char Lexer::findInEscapedChars(char searched) const {
     return res->second;
 }
 
-std::optional<Token> Lexer::buildComment() const {
-    if (source_.getChar() != '#')
-        return std::nullopt;
+Token Lexer::buildComment() const {
     source_.nextChar();
+    const auto contentPosition = source_.getPosition();
 
-    std::string value;
+    lexeme_.clear();
+    source_.skip(findLineEnd, zeroCopy_ ? nullptr : &lexeme_);
 
-    while (source_.getChar() != '\n' && source_.getChar() != EOF) {
-        value.push_back(source_.getChar());
-        source_.nextChar();
+    return Token::withText(Token::Type::CMT, storeText(contentPosition), tokenPosition_);
+}
+
+std::string Lexer::getText(const Token& token) const {
+    if (!hasTextHandle(token))
+        return std::string(token.getText());
+    if (!zeroCopy_)
+        return std::string(texts_.get(token.getTextHandle()));
+    return decodeText(token, source_.getView(getContentPosition(token),
+                                             token.getTextHandle()));
+}
+
+std::string Lexer::getText(const Token& token, std::string_view text) {
+    if (!hasTextHandle(token))
+        return std::string(token.getText());
+    return decodeText(token, text.substr(getContentPosition(token).offset,
+                                         token.getTextHandle()));
+}
+
+std::string Lexer::decodeText(const Token& token, std::string_view content) {
+    if (token.getType() == Token::Type::CMT)
+        return std::string(content);
+
+    std::string text;
+    text.reserve(content.size());
+    for (auto it = content.begin(); it != content.end(); ++it) {
+        if (*it != '\\') {
+            text.push_back(*it);
+            continue;
+        }
+        const auto escaped = std::ranges::find(escapedChars_, *++it, &CharPair::first);
+        text.push_back(escaped->second);
     }
-    return Token(Token::Type::CMT, std::move(value), tokenPosition_);
+    return text;
+}
+
+bool hasTextHandle(const Token& token) {
+    return token.getType() == Token::Type::STR_CONST
+           || token.getType() == Token::Type::CMT;
 }
 
-std::optional<Token> Lexer::buildNotEqualOp() const {
-    if (source_.getChar() != '!')
-        return std::nullopt;
+Position getContentPosition(const Token& token) {
+    // Content follows the opening quotation mark or the hash
+    return {token.getPosition().offset + 1};
+}
 
+Token Lexer::buildNotEqualOp() const {
     source_.nextChar();
 
     if (source_.getChar() == '=') {
@@ -225,57 +357,20 @@ std::optional<Token> Lexer::buildNotEqualOp() const {
     throw InvalidToken(tokenPosition_, '!');
 }
 
-std::optional<Token> Lexer::buildOneLetterOp(char c, Token::Type type) const {
-    if (source_.getChar() != c)
-        return std::nullopt;
-
+Token Lexer::buildOneLetterOp(Token::Type type) const {
     source_.nextChar();
     return Token(type, {}, tokenPosition_);
 }
 
-std::optional<Token> Lexer::buildTwoLetterOp(CharPair chars, TokenTypes types) const {
-    if (source_.getChar() != chars.first)
-        return std::nullopt;
-
+Token Lexer::buildTwoLetterOp(char second, TokenTypes types) const {
     source_.nextChar();
 
-    if (source_.getChar() != chars.second)
+    if (source_.getChar() != second)
         return Token(types.first, {}, tokenPosition_);
 
     source_.nextChar();
     return Token(types.second, {}, tokenPosition_);
 }
 
-Lexer::TokenBuilders Lexer::tokenBuilders_{
-    [](Lexer& l) { return l.buildIdOrKeyword(); },
-    [](Lexer& l) { return l.buildIntConst(); },
-    [](Lexer& l) { return l.buildStrConst(); },
-    [](Lexer& l) { return l.buildComment(); },
-    [](Lexer& l) { return l.buildNotEqualOp(); },
-
-    [](Lexer& l) { return l.buildOneLetterOp(';', Token::Type::SEMI); },
-    [](Lexer& l) { return l.buildOneLetterOp(',', Token::Type::CMA); },
-    [](Lexer& l) { return l.buildOneLetterOp('.', Token::Type::DOT); },
-    [](Lexer& l) { return l.buildOneLetterOp('+', Token::Type::ADD_OP); },
-    [](Lexer& l) { return l.buildOneLetterOp('-', Token::Type::MIN_OP); },
-    [](Lexer& l) { return l.buildOneLetterOp('*', Token::Type::MULT_OP); },
-    [](Lexer& l) { return l.buildOneLetterOp('/', Token::Type::DIV_OP); },
-    [](Lexer& l) { return l.buildOneLetterOp('(', Token::Type::L_PAR); },
-    [](Lexer& l) { return l.buildOneLetterOp(')', Token::Type::R_PAR); },
-    [](Lexer& l) { return l.buildOneLetterOp('{', Token::Type::L_C_BR); },
-    [](Lexer& l) { return l.buildOneLetterOp('}', Token::Type::R_C_BR); },
-    [](Lexer& l) { return l.buildOneLetterOp(EOF, Token::Type::ETX); },
-
-    [](Lexer& l) {
-        return l.buildTwoLetterOp({'<', '='}, {Token::Type::LT_OP, Token::Type::LTE_OP});
-    },
-    [](Lexer& l) {
-        return l.buildTwoLetterOp({'>', '='}, {Token::Type::GT_OP, Token::Type::GTE_OP});
-    },
-    [](Lexer& l) {
-        return l.buildTwoLetterOp({'=', '='}, {Token::Type::ASGN_OP, Token::Type::EQ_OP});
-    },
-};
-
 Lexer::EscapedChars Lexer::escapedChars_{
     {'n', '\n'}, {'t', '\t'}, {'"', '"'}, {'\\', '\\'}};
@@ -1,56 +1,105 @@
 #ifndef LEXER_H
 #define LEXER_H
 
-#include <functional>
+#include <exception>
 #include <optional>
+#include <string>
+#include <string_view>
 
 #include "ILexer.hpp"
 #include "source.hpp"
+#include "text_pool.hpp"
 #include "token.hpp"
 
 /// @brief Lexer that lazily converts characters read from source into tokens
-class Lexer : public ILexer {
+///
+/// Names of identifiers are interned in the global SymbolTable. If the source has a
+/// stable buffer the lexer works in zero-copy mode. Names are then interned straight from
+/// that buffer instead of being copied into a lexeme first, and str literals and comments
+/// are not copied at all: their tokens hold the length of the text following them in the
+/// buffer. Otherwise the text of str literals and comments is kept in the lexer's pool
+class Lexer final : public ILexer {
     using CharPair = std::pair<char, char>;
     using TokenTypes = std::pair<Token::Type, Token::Type>;
 
-    using TokenBuilders =
-        std::initializer_list<std::function<std::optional<Token>(Lexer&)>>;
     using EscapedChars = std::initializer_list<CharPair>;
 
-    using IntWithDigitCount = std::pair<Integral, unsigned int>;
-
    public:
+    /// @brief What to do with comments
+    enum class CommentMode {
+        KEEP,     ///< Return them as CMT tokens, e.g. for tooling
+        DISCARD,  ///< Skip them like whitespace, never building CMT tokens
+    };
+
     /// @brief Constructs a Lexer that reads characters from the source
     /// @param source
-    explicit Lexer(Source& source)
-        : source_(source) {}
+    /// @param commentMode
+    explicit Lexer(Source& source, CommentMode commentMode = CommentMode::KEEP)
+        : source_(source),
+          zeroCopy_(source.hasStableBuffer()),
+          discardComments_(commentMode == CommentMode::DISCARD) {}
 
     /// @brief Returns next token lazily constructed from characters read from source
     /// @return Next token
     Token getToken() override;
 
+    std::size_t getTokens(std::span<Token> tokens) override;
+
+    std::string getText(const Token& token) const override;
+
+    /// @brief Returns text of the token built in zero-copy mode, e.g. by relex(), without
+    /// the lexer
+    /// @param token
+    /// @param text all characters of the source the token was built from
+    /// @return Text of the token or empty string if the token has no text
+    static std::string getText(const Token& token, std::string_view text);
+
    private:
     Source& source_;
     Position tokenPosition_;
+    const bool zeroCopy_;
+    const bool discardComments_;
+
+    /// @brief Exception deferred by getTokens() until the tokens before it are consumed
+    std::exception_ptr pendingError_;
 
+    /// @brief Reused buffer for text of tokens read outside of zero-copy mode
+    mutable std::string lexeme_;
+
+    /// @brief Text of str literals and comments read outside of zero-copy mode
+    mutable TextPool texts_;
+
+    Token buildToken();
+    /// @brief Skips whitespace and, when discarding them, comments
     void ignoreWhiteSpace() const;
 
-    std::optional<Token> buildIdOrKeyword() const;
+    Token buildIdOrKeyword() const;
     std::optional<Token> buildKeyword(std::string_view lexeme) const;
     std::optional<Token> buildBoolConst(std::string_view lexeme) const;
-    std::optional<Token> buildIntConst() const;
-    std::optional<Token> buildFloatConst(Integral integralPart) const;
-    std::optional<Token> buildStrConst() const;
-    std::optional<Token> buildComment() const;
-    std::optional<Token> buildNotEqualOp() const;
-    std::optional<Token> buildOneLetterOp(char c, Token::Type type) const;
-    std::optional<Token> buildTwoLetterOp(CharPair chars, TokenTypes types) const;
-
-    std::optional<IntWithDigitCount> buildNumber() const;
+    Token buildIntConst() const;
+    Token buildFloatConst() const;
+    Token buildStrConst() const;
+    Token buildComment() const;
+    /// @brief Returns text handle of the str literal or comment whose content started at
+    /// the given position and was collected in lexeme_ if not in zero-copy mode
+    std::uint32_t storeText(Position contentPosition) const;
+    Token buildNotEqualOp() const;
+    Token buildOneLetterOp(Token::Type type) const;
+    Token buildTwoLetterOp(char second, TokenTypes types) const;
+
+    Integral parseIntegral(std::string_view digits) const;
+    void appendAndNextChar() const;
+
+    /// @brief Returns text of the token built so far, either viewed in the source or
+    /// collected in lexeme_
+    std::string_view getLexeme() const;
+
     void expectNoEndOfFile() const;
     char findInEscapedChars(char searched) const;
+    /// @brief Returns text of the str literal or comment from its content in the source.
+    /// Escape sequences of str literals are decoded, they were validated while lexing
+    static std::string decodeText(const Token& token, std::string_view content);
 
-    static TokenBuilders tokenBuilders_;
     static EscapedChars escapedChars_;
 };
 
@@ -0,0 +1,56 @@
+#include "mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <system_error>
+
+#include "position.hpp"
+
+static std::system_error lastSystemError(const std::string& message) {
+    return std::system_error(errno, std::generic_category(), message);
+}
+
+MappedFile::MappedFile(const std::string& path) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        throw lastSystemError("Cannot open " + path);
+
+    struct stat fileStat {};
+    if (fstat(fd, &fileStat) == -1) {
+        const auto error = lastSystemError("Cannot stat " + path);
+        close(fd);
+        throw error;
+    }
+
+    size_ = static_cast<std::size_t>(fileStat.st_size);
+
+    // Offsets of characters in a longer file would not fit into Position
+    if (size_ > Position::maxOffset) {
+        close(fd);
+        throw std::system_error(std::make_error_code(std::errc::file_too_large),
+                                "Cannot map " + path);
+    }
+
+    // mmap rejects empty mappings, an empty file simply has no contents
+    if (size_ == 0) {
+        close(fd);
+        return;
+    }
+
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        throw lastSystemError("Cannot map " + path);
+
+    madvise(data, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(data);
+}
+
+MappedFile::~MappedFile() {
+    if (data_)
+        munmap(const_cast<char*>(data_), size_);
+}
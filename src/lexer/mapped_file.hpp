@@ -0,0 +1,33 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/// @brief Read-only memory mapping of a whole file
+///
+/// Lets Source walk the file contents directly instead of reading them through a stream
+class MappedFile {
+   public:
+    /// @brief Maps the file into memory
+    ///
+    /// Throws std::system_error when the file cannot be opened or mapped, or is too large
+    /// for the offsets of Position
+    /// @param path of the file
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// @brief Returns the contents of the file. Valid as long as the MappedFile lives
+    /// @return Contents of the file
+    std::string_view getContents() const { return {data_, size_}; }
+
+   private:
+    const char* data_{nullptr};
+    std::size_t size_{0};
+};
+
+#endif
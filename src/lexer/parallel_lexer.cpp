@@ -0,0 +1,149 @@
+#include "parallel_lexer.hpp"
+
+#include <algorithm>
+
+#include "lexer.hpp"
+#include "scanner.hpp"
+
+const char* skipStrConst(const char* begin, const char* end);
+
+constexpr std::size_t expectedTokenLength{3};
+
+std::vector<std::size_t> findChunkStarts(std::string_view buffer,
+                                         std::size_t chunkCount) {
+    std::vector<std::size_t> chunkStarts{0};
+    const auto minChunkSize = buffer.size() / std::max<std::size_t>(chunkCount, 1);
+
+    const char* const begin = buffer.data();
+    const char* const end = begin + buffer.size();
+    const char* current = begin;
+
+    while (current != end && chunkStarts.size() < chunkCount) {
+        switch (*current) {
+            case '"':
+                current = skipStrConst(current + 1, end);
+                break;
+            case '#':
+                // Quotation marks in comments do not start str literals
+                current = findLineEnd(current, end);
+                break;
+            case '\n': {
+                ++current;
+                const auto offset = static_cast<std::size_t>(current - begin);
+                if (current != end && offset - chunkStarts.back() >= minChunkSize)
+                    chunkStarts.push_back(offset);
+                break;
+            }
+            default:
+                ++current;
+        }
+    }
+    return chunkStarts;
+}
+
+/// @brief Returns pointer past the closing quotation mark of the str literal or end if
+/// it is not terminated
+const char* skipStrConst(const char* begin, const char* end) {
+    while (true) {
+        begin = findQuoteOrBackslash(begin, end);
+        if (begin == end)
+            return end;
+        if (*begin == '"')
+            return begin + 1;
+        // Skip the backslash together with the escaped character
+        begin = end - begin > 2 ? begin + 2 : end;
+    }
+}
+
+ParallelLexer::ParallelLexer(std::string_view buffer, unsigned int threadCount,
+                             std::size_t minChunkSize)
+    : buffer_(buffer) {
+    const auto chunkCount = std::clamp<std::size_t>(buffer.size() / minChunkSize, 1,
+                                                    std::max(threadCount, 1u));
+    const auto chunkStarts = findChunkStarts(buffer, chunkCount);
+
+    chunks_.resize(chunkStarts.size());
+    auto lexChunkAt = [this, buffer, &chunkStarts](std::size_t i) {
+        const bool last = i + 1 == chunkStarts.size();
+        const auto chunkEnd = last ? buffer.size() : chunkStarts[i + 1];
+        const auto chunk = buffer.substr(chunkStarts[i], chunkEnd - chunkStarts[i]);
+        chunks_[i] = lexChunk(chunk, static_cast<std::uint32_t>(chunkStarts[i]), last);
+    };
+
+    {
+        // Lexing happens once per ParallelLexer, so a thread is started for every chunk
+        // but the first one, which is lexed on this thread. A single chunk starts none
+        std::vector<std::jthread> threads;
+        threads.reserve(chunkStarts.size() - 1);
+        for (std::size_t i{1}; i < chunkStarts.size(); ++i)
+            threads.emplace_back(lexChunkAt, i);
+
+        lexChunkAt(0);
+        // The line index is built while the other chunks are still being lexed
+        lineIndex_.addBlock(buffer, 0);
+    }
+}
+
+ParallelLexer::Chunk ParallelLexer::lexChunk(std::string_view chunk, std::uint32_t offset,
+                                             bool last) {
+    Chunk lexed;
+    // Typical programs have a token per every few characters. Reserving up front saves
+    // reallocating (and moving) the tokens lexed so far
+    lexed.tokens.reserve(chunk.size() / expectedTokenLength);
+
+    // The constructor indexes the lines of the whole buffer, the chunk is only validated
+    auto source = Source(chunk, offset, false);
+    source.limitToValidUtf8();
+    auto lexer = Lexer(source);
+
+    try {
+        while (true) {
+            auto token = lexer.getToken();
+            const auto type = token.getType();
+
+            // Only the last chunk ends the text
+            if (type != Token::Type::ETX || last)
+                lexed.tokens.push_back(token);
+            if (type == Token::Type::ETX)
+                break;
+        }
+    } catch (...) {
+        lexed.error = std::current_exception();
+    }
+    return lexed;
+}
+
+Token ParallelLexer::getToken() {
+    Token token;
+    getTokens({&token, 1});
+    return token;
+}
+
+std::size_t ParallelLexer::getTokens(std::span<Token> tokens) {
+    while (true) {
+        const auto& chunk = chunks_[chunkIndex_];
+
+        if (const auto remaining = chunk.tokens.size() - tokenIndex_; remaining > 0) {
+            const auto count = std::min(remaining, tokens.size());
+            std::copy_n(chunk.tokens.begin() + tokenIndex_, count, tokens.begin());
+            tokenIndex_ += count;
+            return count;
+        }
+        if (chunk.error)
+            std::rethrow_exception(chunk.error);
+
+        // Keep returning ETX once the text has ended
+        if (chunkIndex_ + 1 == chunks_.size()) {
+            tokens.front() = chunk.tokens.back();
+            return 1;
+        }
+
+        ++chunkIndex_;
+        tokenIndex_ = 0;
+    }
+}
+
+std::string ParallelLexer::getText(const Token& token) const {
+    // Chunks are lexed in zero-copy mode, the text of the tokens stays in the buffer
+    return Lexer::getText(token, buffer_);
+}
@@ -0,0 +1,65 @@
+#ifndef PARALLEL_LEXER_H
+#define PARALLEL_LEXER_H
+
+#include <exception>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "ILexer.hpp"
+#include "line_index.hpp"
+
+/// @brief Finds offsets at which the buffer can be split into chunks lexed independently
+///
+/// Chunks start right after a new line character that is not a part of a str literal.
+/// Each chunk except the last one is at least buffer.size() / chunkCount long
+/// @param buffer with all characters of the source
+/// @param chunkCount maximal number of chunks
+/// @return Offsets of the chunk starts, the first one is always 0
+std::vector<std::size_t> findChunkStarts(std::string_view buffer, std::size_t chunkCount);
+
+/// @brief Lexer that splits the buffer into chunks, lexes them concurrently and then
+/// returns the merged tokens in order. Implements the same interface as Lexer.
+///
+/// All tokens are produced up front by the constructor. An error found in a chunk is
+/// thrown from getToken() after the tokens preceding it, just like Lexer would do
+class ParallelLexer final : public ILexer {
+   public:
+    static constexpr std::size_t defaultMinChunkSize{1024 * 1024};
+
+    /// @brief Constructs a new ParallelLexer and lexes the whole buffer
+    /// @param buffer with all characters of the source. Must outlive the ParallelLexer
+    /// @param threadCount number of threads lexing the chunks
+    /// @param minChunkSize minimal number of characters worth lexing in a separate chunk
+    explicit ParallelLexer(std::string_view buffer,
+                           unsigned int threadCount = std::thread::hardware_concurrency(),
+                           std::size_t minChunkSize = defaultMinChunkSize);
+
+    Token getToken() override;
+
+    std::size_t getTokens(std::span<Token> tokens) override;
+
+    std::string getText(const Token& token) const override;
+
+    /// @brief Returns the table of line starts of the whole buffer. Used to convert
+    /// positions into lines and columns
+    const LineIndex& getLineIndex() const { return lineIndex_; }
+
+   private:
+    /// @brief Tokens of one chunk. Tokens of a chunk ending with an error are followed by
+    /// that error instead of ETX
+    struct Chunk {
+        std::vector<Token> tokens;
+        std::exception_ptr error;
+    };
+
+    static Chunk lexChunk(std::string_view chunk, std::uint32_t offset, bool last);
+
+    std::string_view buffer_;
+    std::vector<Chunk> chunks_;
+    std::size_t chunkIndex_{0};
+    std::size_t tokenIndex_{0};
+    LineIndex lineIndex_;
+};
+
+#endif
@@ -0,0 +1,373 @@
+#include "scanner.hpp"
+
+#include <bit>
+
+#include "char_classes.hpp"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+using ScanFunction = const char* (*)(const char*, const char*);
+
+const char* skipWhiteSpaceScalar(const char* begin, const char* end) {
+    while (begin != end && isWhiteSpace(*begin))
+        ++begin;
+    return begin;
+}
+
+const char* findLineEndScalar(const char* begin, const char* end) {
+    while (begin != end && *begin != '\n')
+        ++begin;
+    return begin;
+}
+
+const char* findQuoteOrBackslashScalar(const char* begin, const char* end) {
+    while (begin != end && *begin != '"' && *begin != '\\')
+        ++begin;
+    return begin;
+}
+
+const char* skipAsciiScalar(const char* begin, const char* end) {
+    while (begin != end && static_cast<unsigned char>(*begin) < 0x80)
+        ++begin;
+    return begin;
+}
+
+bool isContinuationByte(char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+}
+
+/// @brief Returns length of the UTF-8 sequence starting with the lead byte or 0 if the
+/// byte cannot start one
+std::size_t getSequenceLength(char lead) {
+    const auto byte = static_cast<unsigned char>(lead);
+    if (byte < 0x80)
+        return 1;
+    if (byte < 0xC2)
+        return 0;  // Continuation byte or overlong encoding of ASCII
+    if (byte < 0xE0)
+        return 2;
+    if (byte < 0xF0)
+        return 3;
+    if (byte < 0xF5)
+        return 4;
+    return 0;  // Above U+10FFFF
+}
+
+/// @brief Returns length of the valid UTF-8 sequence at begin or 0 if it is invalid
+std::size_t validateSequence(const char* begin, const char* end) {
+    const auto length = getSequenceLength(*begin);
+    if (length == 0 || end - begin < static_cast<std::ptrdiff_t>(length))
+        return 0;
+
+    // Range of the second byte rules out overlong encodings, surrogates and code points
+    // above U+10FFFF
+    const auto lead = static_cast<unsigned char>(*begin);
+    const auto second = static_cast<unsigned char>(begin[1]);
+    unsigned char low{0x80};
+    unsigned char high{0xBF};
+    if (lead == 0xE0)
+        low = 0xA0;
+    else if (lead == 0xED)
+        high = 0x9F;
+    else if (lead == 0xF0)
+        low = 0x90;
+    else if (lead == 0xF4)
+        high = 0x8F;
+
+    if (second < low || second > high)
+        return 0;
+    for (std::size_t i{2}; i < length; ++i)
+        if (!isContinuationByte(begin[i]))
+            return 0;
+    return length;
+}
+
+/// @brief Checks multibyte sequences one by one. Used for the ranges without whole
+/// blocks and to locate the invalid byte in a block
+template <const char* (*skipAscii)(const char*, const char*)>
+const char* findInvalidUtf8BySequence(const char* begin, const char* end) {
+    while (true) {
+        begin = skipAscii(begin, end);
+        if (begin == end)
+            return end;
+        const auto length = validateSequence(begin, end);
+        if (length == 0)
+            return begin;
+        begin += length;
+    }
+}
+
+#if defined(__x86_64__)
+
+// Stop masks have one bit set for every character the scan stops at
+
+unsigned whiteSpaceStopMask(__m128i chars) {
+    const auto isSpace = _mm_cmpeq_epi8(chars, _mm_set1_epi8(' '));
+    // '\t' to '\r' are the other whitespace characters. After subtracting '\t' they are
+    // the only ones not greater than '\r' - '\t' when compared as unsigned
+    const auto shifted = _mm_sub_epi8(chars, _mm_set1_epi8('\t'));
+    const auto isControl =
+        _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8('\r' - '\t')), shifted);
+    return ~_mm_movemask_epi8(_mm_or_si128(isSpace, isControl)) & 0xFFFF;
+}
+
+unsigned lineEndStopMask(__m128i chars) {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\n')));
+}
+
+unsigned quoteOrBackslashStopMask(__m128i chars) {
+    const auto isQuote = _mm_cmpeq_epi8(chars, _mm_set1_epi8('"'));
+    const auto isBackslash = _mm_cmpeq_epi8(chars, _mm_set1_epi8('\\'));
+    return _mm_movemask_epi8(_mm_or_si128(isQuote, isBackslash));
+}
+
+__attribute__((target("avx2"))) unsigned whiteSpaceStopMask(__m256i chars) {
+    const auto isSpace = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(' '));
+    const auto shifted = _mm256_sub_epi8(chars, _mm256_set1_epi8('\t'));
+    const auto isControl = _mm256_cmpeq_epi8(
+        _mm256_min_epu8(shifted, _mm256_set1_epi8('\r' - '\t')), shifted);
+    return ~static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_or_si256(isSpace, isControl)));
+}
+
+__attribute__((target("avx2"))) unsigned lineEndStopMask(__m256i chars) {
+    return _mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\n')));
+}
+
+__attribute__((target("avx2"))) unsigned quoteOrBackslashStopMask(__m256i chars) {
+    const auto isQuote = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('"'));
+    const auto isBackslash = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\\'));
+    return _mm256_movemask_epi8(_mm256_or_si256(isQuote, isBackslash));
+}
+
+unsigned nonAsciiStopMask(__m128i chars) {
+    return _mm_movemask_epi8(chars);
+}
+
+__attribute__((target("avx2"))) unsigned nonAsciiStopMask(__m256i chars) {
+    return _mm256_movemask_epi8(chars);
+}
+
+/// @brief Scans whole 16 byte blocks with SSE2, the remaining tail with the scalar scan
+template <unsigned (*stopMask)(__m128i), ScanFunction scanScalar>
+const char* scanSse2(const char* begin, const char* end) {
+    for (; end - begin >= 16; begin += 16) {
+        const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        if (const auto mask = stopMask(chars))
+            return begin + std::countr_zero(mask);
+    }
+    return scanScalar(begin, end);
+}
+
+/// @brief Scans whole 32 byte blocks with AVX2, the remaining tail with SSE2
+template <unsigned (*stopMask)(__m256i), ScanFunction scanSse2>
+__attribute__((target("avx2"))) const char* scanAvx2(const char* begin, const char* end) {
+    for (; end - begin >= 32; begin += 32) {
+        const auto chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+        if (const auto mask = stopMask(chars))
+            return begin + std::countr_zero(mask);
+    }
+    return scanSse2(begin, end);
+}
+
+// Errors of pairs of subsequent bytes, looked up by the nibbles of both bytes. A pair is
+// invalid if all three lookups share an error bit
+constexpr char tooShort{1 << 0};     // 11______ 0_______ or 11______ 11______
+constexpr char tooLong{1 << 1};      // 0_______ 10______
+constexpr char overlong3{1 << 2};    // 11100000 100_____
+constexpr char tooLarge{1 << 3};     // 11110100 1001____ or above
+constexpr char surrogate{1 << 4};    // 11101101 101_____
+constexpr char overlong2{1 << 5};    // 1100000_ 10______
+constexpr char tooLarge1000{1 << 6}; // 11110101 1000____ or above
+constexpr char overlong4{1 << 6};    // 11110000 1000____
+constexpr char twoConts{static_cast<char>(1 << 7)};  // 10______ 10______
+constexpr char carry = tooShort | tooLong | twoConts;
+
+__attribute__((target("avx2"))) __m256i lookup(__m256i nibbles, __m256i table) {
+    return _mm256_shuffle_epi8(table, nibbles);
+}
+
+__attribute__((target("avx2"))) __m256i highNibbles(__m256i bytes) {
+    return _mm256_and_si256(_mm256_srli_epi16(bytes, 4), _mm256_set1_epi8(0x0F));
+}
+
+/// @brief Returns the bytes of input preceded by the last count bytes of previous
+template <int count>
+__attribute__((target("avx2"))) __m256i shiftIn(__m256i input, __m256i previous) {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21),
+                              16 - count);
+}
+
+/// @brief Returns non-zero bytes where the block has invalid sequences. Sequences
+/// cut off by the end of the block are completed by the next one
+__attribute__((target("avx2"))) __m256i findUtf8Errors(__m256i input, __m256i previous) {
+    const auto previous1 = shiftIn<1>(input, previous);
+
+    const auto byte1High = lookup(
+        highNibbles(previous1),
+        _mm256_setr_epi8(tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, tooLong,
+                         tooLong, twoConts, twoConts, twoConts, twoConts,
+                         tooShort | overlong2, tooShort, tooShort | overlong3 | surrogate,
+                         tooShort | tooLarge | tooLarge1000 | overlong4, tooLong, tooLong,
+                         tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, twoConts,
+                         twoConts, twoConts, twoConts, tooShort | overlong2, tooShort,
+                         tooShort | overlong3 | surrogate,
+                         tooShort | tooLarge | tooLarge1000 | overlong4));
+
+    constexpr char large = carry | tooLarge | tooLarge1000;
+    const auto byte1Low = lookup(
+        _mm256_and_si256(previous1, _mm256_set1_epi8(0x0F)),
+        _mm256_setr_epi8(carry | overlong3 | overlong2 | overlong4, carry | overlong2,
+                         carry, carry, carry | tooLarge, large, large, large, large,
+                         large, large, large, large, large | surrogate, large, large,
+                         carry | overlong3 | overlong2 | overlong4, carry | overlong2,
+                         carry, carry, carry | tooLarge, large, large, large, large,
+                         large, large, large, large, large | surrogate, large, large));
+
+    constexpr char cont1000 = tooLong | overlong2 | twoConts | overlong3 | tooLarge1000
+                              | overlong4;
+    constexpr char cont1001 = tooLong | overlong2 | twoConts | overlong3 | tooLarge;
+    constexpr char cont101 = tooLong | overlong2 | twoConts | surrogate | tooLarge;
+    const auto byte2High = lookup(
+        highNibbles(input),
+        _mm256_setr_epi8(tooShort, tooShort, tooShort, tooShort, tooShort, tooShort,
+                         tooShort, tooShort, cont1000, cont1001, cont101, cont101,
+                         tooShort, tooShort, tooShort, tooShort, tooShort, tooShort,
+                         tooShort, tooShort, tooShort, tooShort, tooShort, tooShort,
+                         cont1000, cont1001, cont101, cont101, tooShort, tooShort,
+                         tooShort, tooShort));
+
+    const auto pairErrors =
+        _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+
+    // Third and fourth bytes of sequences must be continuation bytes. twoConts error of
+    // such pairs is expected, anywhere else it is an error
+    const auto isThird =
+        _mm256_subs_epu8(shiftIn<2>(input, previous), _mm256_set1_epi8(0xE0 - 0x80));
+    const auto isFourth =
+        _mm256_subs_epu8(shiftIn<3>(input, previous), _mm256_set1_epi8(0xF0 - 0x80));
+    const auto mustBeContinuation = _mm256_and_si256(_mm256_or_si256(isThird, isFourth),
+                                                     _mm256_set1_epi8(twoConts));
+    return _mm256_xor_si256(mustBeContinuation, pairErrors);
+}
+
+__attribute__((target("avx2"))) bool hasErrors(__m256i errors) {
+    return !_mm256_testz_si256(errors, errors);
+}
+
+/// @brief Validates whole 32 byte blocks with AVX2, the remaining tail sequence by
+/// sequence
+template <const char* (*findBySequence)(const char*, const char*)>
+__attribute__((target("avx2"))) const char* findInvalidUtf8Avx2(const char* begin,
+                                                                const char* end) {
+    const char* const first = begin;
+    auto previous = _mm256_setzero_si256();
+
+    for (; end - begin >= 32; begin += 32) {
+        const auto input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+        // Blocks of ASCII are valid on their own
+        const bool ascii = _mm256_movemask_epi8(input) == 0;
+        if ((!ascii || _mm256_movemask_epi8(previous) != 0)
+            && hasErrors(findUtf8Errors(input, previous)))
+            break;
+        previous = input;
+    }
+
+    // The invalid sequence (or the one continued by the tail) may start up to three bytes
+    // before, so the search resumes from the lead byte of the sequence not ending there
+    const char* resume = begin;
+    for (std::ptrdiff_t i{1}; i <= 3 && i <= begin - first; ++i) {
+        if (!isContinuationByte(begin[-i])) {
+            const auto length = static_cast<std::ptrdiff_t>(getSequenceLength(begin[-i]));
+            if (length == 0 || length > i)
+                resume = begin - i;
+            break;
+        }
+    }
+    return findBySequence(resume, end);
+}
+
+/// @brief Picks the widest kernel supported by the CPU
+ScanFunction selectKernel(ScanFunction sse2, ScanFunction avx2) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? avx2 : sse2;
+}
+
+constexpr auto skipWhiteSpaceSse2 = scanSse2<whiteSpaceStopMask, skipWhiteSpaceScalar>;
+constexpr auto findLineEndSse2 = scanSse2<lineEndStopMask, findLineEndScalar>;
+constexpr auto findQuoteOrBackslashSse2 =
+    scanSse2<quoteOrBackslashStopMask, findQuoteOrBackslashScalar>;
+
+// Kernels are picked on first use by function-local statics. Namespace-scope ones could
+// still be null when a Source is used during static initialization of another file
+
+ScanFunction skipWhiteSpaceKernel() {
+    static const ScanFunction kernel = selectKernel(
+        skipWhiteSpaceSse2, scanAvx2<whiteSpaceStopMask, skipWhiteSpaceSse2>);
+    return kernel;
+}
+
+ScanFunction findLineEndKernel() {
+    static const ScanFunction kernel =
+        selectKernel(findLineEndSse2, scanAvx2<lineEndStopMask, findLineEndSse2>);
+    return kernel;
+}
+
+ScanFunction findQuoteOrBackslashKernel() {
+    static const ScanFunction kernel =
+        selectKernel(findQuoteOrBackslashSse2,
+                     scanAvx2<quoteOrBackslashStopMask, findQuoteOrBackslashSse2>);
+    return kernel;
+}
+
+constexpr auto skipAsciiSse2 = scanSse2<nonAsciiStopMask, skipAsciiScalar>;
+constexpr auto skipAsciiAvx2 = scanAvx2<nonAsciiStopMask, skipAsciiSse2>;
+constexpr auto findInvalidUtf8Sse2 = findInvalidUtf8BySequence<skipAsciiSse2>;
+
+ScanFunction findInvalidUtf8Kernel() {
+    static const ScanFunction kernel = selectKernel(
+        findInvalidUtf8Sse2,
+        findInvalidUtf8Avx2<findInvalidUtf8BySequence<skipAsciiAvx2>>);
+    return kernel;
+}
+
+#else
+
+ScanFunction skipWhiteSpaceKernel() { return skipWhiteSpaceScalar; }
+ScanFunction findLineEndKernel() { return findLineEndScalar; }
+ScanFunction findQuoteOrBackslashKernel() { return findQuoteOrBackslashScalar; }
+ScanFunction findInvalidUtf8Kernel() {
+    return findInvalidUtf8BySequence<skipAsciiScalar>;
+}
+
+#endif
+
+const char* skipWhiteSpace(const char* begin, const char* end) {
+    return skipWhiteSpaceKernel()(begin, end);
+}
+
+const char* findLineEnd(const char* begin, const char* end) {
+    return findLineEndKernel()(begin, end);
+}
+
+const char* findQuoteOrBackslash(const char* begin, const char* end) {
+    return findQuoteOrBackslashKernel()(begin, end);
+}
+
+const char* findInvalidUtf8(const char* begin, const char* end) {
+    return findInvalidUtf8Kernel()(begin, end);
+}
+
+std::size_t countMissingUtf8Bytes(const char* begin, const char* end) {
+    // The lead byte of the last sequence is at most three bytes before the end
+    for (const char* lead = end; lead != begin && end - lead < 4;) {
+        if (!isContinuationByte(*--lead)) {
+            const auto length = getSequenceLength(*lead);
+            const auto present = static_cast<std::size_t>(end - lead);
+            return length > present ? length - present : 0;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,34 @@
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include <cstddef>
+
+/// Kernels scanning character ranges in bulk. Each one returns pointer to the first
+/// character in [begin, end) it stops at or end if there is none.
+///
+/// On x86-64 SSE2 or AVX2 versions are used, depending on what the CPU supports.
+/// Other platforms use scalar versions
+
+/// @brief Finds the first character that is not whitespace (as in std::isspace)
+const char* skipWhiteSpace(const char* begin, const char* end);
+
+/// @brief Finds the first new line character
+const char* findLineEnd(const char* begin, const char* end);
+
+/// @brief Finds the first character ending an escape-free span of a str literal, i.e.
+/// quotation mark or backslash
+const char* findQuoteOrBackslash(const char* begin, const char* end);
+
+/// @brief Finds the first byte that does not start a valid UTF-8 sequence. A sequence cut
+/// off by end is invalid too
+///
+/// The AVX2 version validates whole blocks at once (lookup algorithm of Keiser and
+/// Lemire) and only looks for the exact byte in a block found invalid. Other versions
+/// skip ASCII in bulk and check multibyte sequences one by one
+const char* findInvalidUtf8(const char* begin, const char* end);
+
+/// @brief Returns how many continuation bytes the UTF-8 sequence at the end of the range
+/// lacks, e.g. when a block read from a stream ends in the middle of a character
+std::size_t countMissingUtf8Bytes(const char* begin, const char* end);
+
+#endif
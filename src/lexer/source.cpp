@@ -0,0 +1,53 @@
+#include "source.hpp"
+
+#include <algorithm>
+
+#include "scanner.hpp"
+
+void Source::refill() {
+    if (!stream_ || invalidUtf8_)
+        return;
+
+    blockOffset_ += end_ - blockBegin_;
+
+    auto read = [this](char* begin, std::size_t count) {
+        const auto read =
+            stream_->rdbuf()->sgetn(begin, static_cast<std::streamsize>(count));
+        return static_cast<std::size_t>(std::max<std::streamsize>(read, 0));
+    };
+
+    auto capacity = buffer_.size() - maxMissingUtf8Bytes;
+    // sgetc() waits for a single read from the stream, the rest of the block would wait
+    // until all of it arrives
+    if (shortReads_ && stream_->rdbuf()->sgetc() != EOF)
+        capacity = std::min(capacity,
+                            static_cast<std::size_t>(stream_->rdbuf()->in_avail()));
+
+    auto count = read(buffer_.data(), capacity);
+    // Complete the multibyte character cut off by the end of the block
+    const auto missing = countMissingUtf8Bytes(buffer_.data(), buffer_.data() + count);
+    if (missing)
+        count += read(buffer_.data() + count, missing);
+    // Earlier blocks were checked, so blockOffset_ is at most maxOffset
+    if (count > Position::maxOffset - blockOffset_)
+        throw SourceTooLarge();
+
+    blockBegin_ = buffer_.data();
+    current_ = blockBegin_;
+    end_ = current_ + count;
+
+    lineIndex_.addBlock({current_, end_}, static_cast<std::uint32_t>(blockOffset_));
+    limitToValidUtf8();
+}
+
+bool Source::isDrained() const {
+    return shortReads_ && skipWhiteSpace(current_, end_) == end_;
+}
+
+void Source::limitToValidUtf8() {
+    const auto invalid = findInvalidUtf8(current_, end_);
+    if (invalid != end_) {
+        end_ = invalid;
+        invalidUtf8_ = true;
+    }
+}
@@ -1,45 +1,165 @@
 #ifndef SOURCE_H
 #define SOURCE_H
 
+#include <cstdio>
 #include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
 
+#include "lexer_errors.hpp"
+#include "line_index.hpp"
 #include "position.hpp"
 
 /// @brief Source of characters that keeps track of current character and its position
+///
+/// Characters are walked through a contiguous buffer. The buffer is either provided
+/// up front (e.g. a memory-mapped file) or refilled from a stream when exhausted
 class Source {
    public:
-    /// @brief Constructs a new Source
+    static constexpr std::size_t defaultBlockSize{64 * 1024};
+
+    /// @brief Constructs a new Source reading from the stream in blocks
     ///
-    /// Immediately reads the first character by calling nextChar()
+    /// Immediately reads the first block
     /// @param stream from which characters will be read
-    explicit Source(std::istream& stream)
-        : stream_(stream) {
-        currentChar_ = stream_.get();
+    /// @param blockSize number of characters read from the stream at once. A block may
+    /// be up to 3 characters longer, so it never ends in the middle of a UTF-8 sequence
+    /// @param shortReads whether a block takes only what the stream has at hand, waiting
+    /// for more only when it has nothing. Lets input arriving piece by piece (e.g. from a
+    /// pipe) be processed before a whole block of it is available
+    explicit Source(std::istream& stream, std::size_t blockSize = defaultBlockSize,
+                    bool shortReads = false)
+        : stream_(&stream),
+          buffer_(blockSize + maxMissingUtf8Bytes),
+          shortReads_(shortReads) {
+        refill();
+        updateCurrentChar();
     }
 
+    /// @brief Constructs a new Source walking the in-memory buffer
+    ///
+    /// Throws SourceTooLarge if the buffer ends past Position::maxOffset
+    /// @param buffer with all characters of the source. Must outlive the Source
+    /// @param baseOffset offset of the first character of the buffer. Non-zero when the
+    /// buffer is only a part of a bigger file
+    /// @param prescan whether to build the line index and validate UTF-8 up front.
+    /// Scanning the whole buffer is a waste when only a part of it is going to be read,
+    /// the caller is then responsible for validating that part
+    explicit Source(std::string_view buffer, std::uint32_t baseOffset = 0,
+                    bool prescan = true)
+        : blockOffset_(baseOffset),
+          blockBegin_(buffer.data()),
+          current_(buffer.data()),
+          end_(buffer.data() + buffer.size()) {
+        if (baseOffset > Position::maxOffset
+            || buffer.size() > Position::maxOffset - baseOffset)
+            throw SourceTooLarge();
+        if (prescan) {
+            lineIndex_.addBlock(buffer, baseOffset);
+            limitToValidUtf8();
+        }
+        updateCurrentChar();
+    }
+
+    Source(const Source&) = delete;
+    Source& operator=(const Source&) = delete;
+
     /// @brief Returns current character
     /// @return Current character
     char getChar() const { return currentChar_; }
 
     /// @brief Returns position of current character
     /// @return Position of current character
-    const Position& getPosition() const { return currentPosition_; }
+    Position getPosition() const {
+        return {static_cast<std::uint32_t>(blockOffset_ + (current_ - blockBegin_))};
+    }
+
+    /// @brief Checks if the source ended early at a character that is not a part of a
+    /// valid UTF-8 sequence. Once EOF is reached, getPosition() returns its position
+    bool hasInvalidUtf8() const { return invalidUtf8_; }
+
+    /// @brief Checks if all characters stay in one buffer that outlives the Source, so
+    /// views returned by getView() remain valid
+    bool hasStableBuffer() const { return !stream_; }
+
+    /// @brief Checks if only white space is left of the characters read so far, so
+    /// reading on would wait for the stream. Always false without short reads
+    bool isDrained() const;
+
+    /// @brief Returns characters from the given position up to the current character
+    ///
+    /// Only available for sources with stable buffer
+    /// @param from position of the first returned character
+    std::string_view getView(Position from) const {
+        return {blockBegin_ + (from.offset - blockOffset_), current_};
+    }
 
-    /// @brief Reads next character and calculates its position
+    /// @brief Returns the given number of characters from the given position. Unlike
+    /// the other getView() it may be called while another thread reads the source
+    ///
+    /// Only available for sources with stable buffer
+    /// @param from position of the first returned character
+    /// @param length number of returned characters
+    std::string_view getView(Position from, std::size_t length) const {
+        return {blockBegin_ + (from.offset - blockOffset_), length};
+    }
+
+    /// @brief Returns the table of line starts of the characters read so far. Used to
+    /// convert positions into lines and columns
+    const LineIndex& getLineIndex() const { return lineIndex_; }
+
+    /// @brief Reads next character
     void nextChar() {
-        if (currentChar_ == '\n') {
-            currentPosition_.line += 1;
-            currentPosition_.column = 0;
-        }
+        if (current_ != end_ && ++current_ == end_)
+            refill();
+        updateCurrentChar();
+    }
 
-        currentChar_ = stream_.get();
-        currentPosition_.column += 1;
+    /// @brief Skips characters in bulk, refilling the buffer as needed
+    /// @param scan function returning pointer to the first character in [begin, end) that
+    /// should not be skipped or end if all of them should
+    /// @param skipped if not null, skipped characters are appended to it
+    template <typename Scan>
+    void skip(Scan scan, std::string* skipped = nullptr) {
+        while (current_ != end_) {
+            const auto stop = scan(current_, end_);
+            if (skipped)
+                skipped->append(current_, stop);
+            current_ = stop;
+            if (current_ != end_)
+                break;
+            refill();
+        }
+        updateCurrentChar();
     }
 
+    /// @brief Moves the end of the buffer to the first invalid UTF-8 sequence in it, so
+    /// reading stops right before it. Validates a buffer that was not prescanned
+    void limitToValidUtf8();
+
    private:
-    std::istream& stream_;
+    static constexpr std::size_t maxMissingUtf8Bytes{3};
+
+    /// @brief Replaces the exhausted buffer with the next block read from the stream.
+    /// Leaves the buffer empty when there is no stream or it has ended. Throws
+    /// SourceTooLarge if the block ends past Position::maxOffset
+    void refill();
+
+    void updateCurrentChar() { currentChar_ = current_ != end_ ? *current_ : EOF; }
+
+    std::istream* stream_{nullptr};
+    std::vector<char> buffer_;
+    bool shortReads_{false};
+
+    std::size_t blockOffset_{0};
+    const char* blockBegin_{nullptr};
+    const char* current_{nullptr};
+    const char* end_{nullptr};
+
     char currentChar_{};
-    Position currentPosition_{1, 1};
+    bool invalidUtf8_{false};
+    LineIndex lineIndex_;
 };
 
 #endif
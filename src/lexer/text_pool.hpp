@@ -0,0 +1,41 @@
+#ifndef TEXT_POOL_H
+#define TEXT_POOL_H
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+
+/// @brief Texts of str literals and comments kept by a lexer reading from a stream, which
+/// drops characters once they are read
+///
+/// Texts are only ever added, they are all freed together with the pool. Safe to read
+/// from one thread while another one adds, e.g. the lexer decorated by ThreadedLexer
+class TextPool {
+   public:
+    /// @brief Stores a copy of the text
+    /// @param text
+    /// @return Id of the copy
+    std::uint32_t add(std::string_view text) {
+        const std::unique_lock lock(mutex_);
+        texts_.emplace_back(text);
+        return static_cast<std::uint32_t>(texts_.size() - 1);
+    }
+
+    /// @brief Returns the text with the given id. Valid as long as the pool exists
+    /// @param id returned by add()
+    /// @return Text
+    std::string_view get(std::uint32_t id) const {
+        const std::shared_lock lock(mutex_);
+        return texts_[id];
+    }
+
+   private:
+    mutable std::shared_mutex mutex_;
+    // Deque never moves the stored texts, so views of them stay valid
+    std::deque<std::string> texts_;
+};
+
+#endif
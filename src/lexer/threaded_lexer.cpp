@@ -0,0 +1,71 @@
+#include "threaded_lexer.hpp"
+
+ThreadedLexer::ThreadedLexer(ILexer& lexer)
+    : lexer_(lexer),
+      producer_([this](std::stop_token stopToken) { produce(stopToken); }) {}
+
+ThreadedLexer::~ThreadedLexer() {
+    // The producer may wait for free space in the ring, clearing it lets it notice the
+    // stop request
+    producer_.request_stop();
+    ring_.clear();
+}
+
+void ThreadedLexer::produce(std::stop_token stopToken) {
+    bool finished{false};
+
+    while (!finished && !stopToken.stop_requested()) {
+        Batch batch;
+        batch.reserve(batchSize);
+
+        while (!finished && batch.size() < batchSize) {
+            Entry entry;
+            try {
+                entry.token = lexer_.getToken();
+            } catch (...) {
+                entry.error = std::current_exception();
+            }
+
+            finished = entry.error || entry.token.getType() == Token::Type::ETX;
+            batch.push_back(std::move(entry));
+        }
+
+        if (!ring_.push(std::move(batch), stopToken))
+            return;
+    }
+}
+
+Token ThreadedLexer::getToken() {
+    Token token;
+    getTokens({&token, 1});
+    return token;
+}
+
+std::size_t ThreadedLexer::getTokens(std::span<Token> tokens) {
+    std::size_t count{0};
+
+    while (!finished_ && count < tokens.size()) {
+        if (batchIndex_ == batch_.size()) {
+            // Hand out what is already there instead of waiting for the producer
+            if (count > 0)
+                return count;
+            batch_ = ring_.pop();
+            batchIndex_ = 0;
+        }
+
+        auto& entry = batch_[batchIndex_++];
+        finished_ = entry.error || entry.token.getType() == Token::Type::ETX;
+        if (finished_)
+            last_ = std::move(entry);
+        else
+            tokens[count++] = std::move(entry.token);
+    }
+
+    // The error is thrown once the tokens preceding it are consumed
+    if (count > 0)
+        return count;
+    if (last_.error)
+        std::rethrow_exception(last_.error);
+    tokens.front() = last_.token;
+    return 1;
+}
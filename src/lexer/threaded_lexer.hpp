@@ -0,0 +1,68 @@
+#ifndef THREADED_LEXER_H
+#define THREADED_LEXER_H
+
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "ILexer.hpp"
+#include "spsc_ring.hpp"
+
+/// @brief Lexer adapter running the decorated ILexer on a separate producer thread.
+/// Implements the same interface as Lexer.
+///
+/// Tokens are passed in batches through a lock-free ring, so lexing overlaps with
+/// whatever consumes the tokens (usually Parser). Batching keeps the threads from waking
+/// each other up for every single token. An exception thrown by the decorated lexer is
+/// rethrown from getToken() after all tokens preceding it
+class ThreadedLexer final : public ILexer {
+   public:
+    static constexpr std::size_t batchSize{1024};
+    static constexpr std::size_t ringCapacity{8};
+
+    /// @brief Constructs a new ThreadedLexer and starts lexing
+    /// @param lexer decorated lexer. Must not be used by anyone else until the
+    /// ThreadedLexer is destroyed
+    explicit ThreadedLexer(ILexer& lexer);
+
+    /// @brief Stops the producer thread even if it has not reached the end of text
+    ~ThreadedLexer();
+
+    ThreadedLexer(const ThreadedLexer&) = delete;
+    ThreadedLexer& operator=(const ThreadedLexer&) = delete;
+
+    /// @brief Returns the next token produced by the decorated lexer
+    ///
+    /// After the end-of-text token or an exception it keeps returning (or throwing) the
+    /// same
+    Token getToken() override;
+
+    std::size_t getTokens(std::span<Token> tokens) override;
+
+    std::string getText(const Token& token) const override {
+        return lexer_.getText(token);
+    }
+
+   private:
+    /// @brief Either a token or an exception thrown instead of it
+    struct Entry {
+        Token token;
+        std::exception_ptr error;
+    };
+
+    using Batch = std::vector<Entry>;
+
+    void produce(std::stop_token stopToken);
+
+    ILexer& lexer_;
+    SpscRing<Batch, ringCapacity> ring_;
+    Batch batch_;
+    std::size_t batchIndex_{0};
+    Entry last_;
+    bool finished_{false};
+
+    // Started last, when everything it uses is already initialized
+    std::jthread producer_;
+};
+
+#endif
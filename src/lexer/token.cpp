@@ -12,13 +12,38 @@ std::vector<Token::Type> Token::constantTypes_{
     Token::Type::FALSE_CONST, Token::Type::STR_CONST,
 };
 
+/// @brief Index of the alternative T in Token::Value
+template <typename T>
+constexpr std::size_t valueIndex{Token::Value(T{}).index()};
+
+Token::Value Token::getValue() const {
+    switch (valueIndex_) {
+        case valueIndex<Integral>:
+            return std::bit_cast<Integral>(payload_);
+        case valueIndex<Floating>:
+            return std::bit_cast<Floating>(payload_);
+        case valueIndex<bool>:
+            return payload_ != 0;
+        case valueIndex<Symbol>:
+            return Symbol::fromId(payload_);
+        default:
+            return {};
+    }
+}
+
+std::string_view Token::getText() const {
+    if (valueIndex_ == valueIndex<Symbol>)
+        return Symbol::fromId(payload_).getName();
+    return {};
+}
+
 /// @brief Visitor converting tokens into strings
 struct ToStringFunctor {
     std::string operator()(std::monostate) const { return ""; }
     std::string operator()(Integral i) const { return std::to_string(i); }
     std::string operator()(Floating i) const { return std::to_string(i); }
     std::string operator()(bool b) const { return std::to_string(b); }
-    std::string operator()(const std::string& s) const { return s; }
+    std::string operator()(Symbol s) const { return std::string(s.getName()); }
 };
 
 std::ostream& operator<<(std::ostream& stream, const Token& token) {
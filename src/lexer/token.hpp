@@ -1,7 +1,11 @@
 #ifndef TOKEN_H
 #define TOKEN_H
 
+#include <bit>
+#include <cstdint>
 #include <ostream>
+#include <string_view>
+#include <type_traits>
 #include <variant>
 #include <vector>
 
@@ -13,7 +17,7 @@ struct Position;
 /// @brief Token returned by lexer and used by parser
 class Token {
    public:
-    enum class Type {
+    enum class Type : std::uint8_t {
         UNKNOWN,
         IF_KW,
         WHILE_KW,
@@ -61,36 +65,82 @@ class Token {
         CMT,
     };
 
-    using Value = std::variant<std::monostate, Integral, Floating, bool, std::string>;
+    /// @brief Value of the token. Names of identifiers are interned as symbols. Str
+    /// literals and comments have no value, their text is resolved by the lexer
+    using Value = std::variant<std::monostate, Integral, Floating, bool, Symbol>;
 
     /// @param type
     /// @param value
     /// @param position - position of the first character of the token
     Token(Type type, Value value, Position position)
-        : type_(type), value_(value), position_(position) {}
+        : type_(type),
+          valueIndex_(static_cast<std::uint8_t>(value.index())),
+          position_(position),
+          payload_(encode(value)) {}
 
     /// @brief Constructs a token of type unknown
-    Token()
-        : type_(Type::UNKNOWN) {}
+    Token() = default;
+
+    /// @brief Constructs a str literal or comment token
+    /// @param type
+    /// @param textHandle - what the lexer keeps the text of the token under
+    /// @param position - position of the first character of the token
+    static Token withText(Type type, std::uint32_t textHandle, Position position) {
+        Token token(type, {}, position);
+        token.payload_ = textHandle;
+        return token;
+    }
 
     Type getType() const { return type_; }
-    const Value& getValue() const { return value_; }
+
+    /// @brief Returns value of the token, decoded from its compact representation
+    Value getValue() const;
+
+    /// @brief Returns name of an identifier. Text of str literals and comments is
+    /// resolved by the lexer (ILexer::getText())
+    /// @return Name of the identifier or empty string for other tokens
+    std::string_view getText() const;
+
+    /// @brief Returns what the lexer keeps the text of a str literal or comment under
+    std::uint32_t getTextHandle() const { return payload_; }
 
     /// @brief Returns position of the first character of the token
     /// @return Position of the first character of the token
     const Position& getPosition() const { return position_; }
+    void setPosition(Position position) { position_ = position; }
 
     /// @brief Is one of the constants (e.g. int, bool, str)
     bool isConstant() const;
 
    private:
-    Type type_;
-    Value value_ = {};
+    /// @brief Encodes each kind of value in 32 bits
+    static std::uint32_t encode(const Value& value) {
+        if (const auto symbol = std::get_if<Symbol>(&value))
+            return symbol->getId();
+        if (const auto integral = std::get_if<Integral>(&value))
+            return std::bit_cast<std::uint32_t>(*integral);
+        if (const auto floating = std::get_if<Floating>(&value))
+            return std::bit_cast<std::uint32_t>(*floating);
+        if (const auto boolean = std::get_if<bool>(&value))
+            return *boolean;
+        return 0;
+    }
+
+    // Tokens are copied a lot (batches, rings), so they are kept small and trivially
+    // copyable: the type, index of the value alternative, position and the value itself
+    Type type_{Type::UNKNOWN};
+    std::uint8_t valueIndex_{0};
     Position position_;
+    std::uint32_t payload_{0};
 
     static std::vector<Token::Type> constantTypes_;
 };
 
+static_assert(sizeof(Integral) == 4 && sizeof(Floating) == 4,
+              "Numeric values must fit into the token payload");
+static_assert(std::is_trivially_copyable_v<Token>);
+static_assert(sizeof(Token) <= 16);
+
 std::ostream& operator<<(std::ostream& stream, const Token& token);
 
 #endif
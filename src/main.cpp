@@ -1,28 +1,95 @@
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <system_error>
+#include <thread>
+
+#include <unistd.h>
 
 #include "base_errors.hpp"
-#include "filter.hpp"
 #include "interpreter.hpp"
 #include "lexer.hpp"
+#include "mapped_file.hpp"
 #include "parser.hpp"
+#include "repl.hpp"
+#include "threaded_lexer.hpp"
+
+void interpret(ILexer& lexer, bool pipelined) {
+    auto parser = Parser(lexer);
+    Interpreter interpreter(std::cout);
+
+    if (!pipelined) {
+        const auto program = parser.parseProgram();
+        interpreter.interpret(program);
+        return;
+    }
+
+    // Every statement runs as soon as it is parsed and is freed right after, unless it
+    // defines something
+    while (true) {
+        auto fragment = parser.parseNextStatement();
+        if (fragment.statements.empty())
+            break;
+        interpreter.interpret(std::move(fragment));
+    }
+}
+
+void run(Source& source, bool pipelined) {
+    try {
+        // Comments are of no use to the interpreter, so they are never turned into tokens
+        auto lexer = Lexer(source, Lexer::CommentMode::DISCARD);
+
+        // Lexing overlaps with parsing when there is a spare core for it. Not for
+        // streamed statements run one by one, lexing ahead would wait for input they do
+        // not need
+        const bool streamedPipeline = pipelined && !source.hasStableBuffer();
+        if (std::thread::hardware_concurrency() > 1 && !streamedPipeline) {
+            auto threadedLexer = ThreadedLexer(lexer);
+            interpret(threadedLexer, pipelined);
+        } else {
+            interpret(lexer, pipelined);
+        }
+    } catch (const BaseException& e) {
+        std::cerr << '\n' << e.describe(source.getLineIndex()) << '\n';
+    }
+}
 
 int main(int argc, char* argv[]) {
     if (argc < 2)
         return -1;
 
-    std::ifstream ifs(argv[1]);
-    auto source = Source(ifs);
+    std::string path{argv[1]};
 
-    try {
-        auto lexer = Lexer(source);
-        auto filter = Filter(lexer, Token::Type::CMT);
-        auto parser = Parser(filter);
-        const auto program = parser.parseProgram();
+    // Statements read from the standard input are run as soon as they are complete
+    if (path == "--repl") {
+        Repl(std::cout, std::cerr).run(std::cin, isatty(STDIN_FILENO));
+        return 0;
+    }
 
-        Interpreter interpreter(std::cout);
-        interpreter.interpret(program);
-    } catch (const BaseException& e) {
-        std::cerr << '\n' << e.describe() << '\n';
+    // Statements are run while the rest of the program is being parsed. A syntax error
+    // is then reported only after the statements preceding it have run
+    const bool pipelined = path == "--pipelined";
+    if (pipelined) {
+        if (argc < 3)
+            return -1;
+        path = argv[2];
+    }
+
+    // Regular files are mapped into memory, anything else (e.g. pipes) is streamed
+    if (std::filesystem::is_regular_file(path)) {
+        try {
+            const MappedFile file(path);
+            auto source = Source(file.getContents());
+            run(source, pipelined);
+        } catch (const std::system_error& e) {
+            // E.g. the file is not readable
+            std::cerr << e.what() << '\n';
+            return -1;
+        }
+    } else {
+        // Pipelined statements run as soon as they arrive instead of after a whole block
+        std::ifstream ifs(path);
+        auto source = Source(ifs, Source::defaultBlockSize, pipelined);
+        run(source, pipelined);
     }
 }
@@ -0,0 +1,140 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+/// @brief Deleter of objects allocated in an Arena. Only destroys the object, its memory
+/// is released together with the whole arena
+///
+/// Nodes own their children, so destroying a node would recurse as deep as the tree is.
+/// Instead, objects whose deletion starts while another one is being destroyed are only
+/// queued, and the outermost deletion destroys them one after another. So even trees
+/// nested deeper than the native stack allows are destroyed safely
+class ArenaDeleter {
+   public:
+    template <typename T>
+    void operator()(T* object) const {
+        destroy(object, [](void* queued) { std::destroy_at(static_cast<T*>(queued)); });
+    }
+
+   private:
+    using Destructor = void (*)(void*);
+
+    static void destroy(void* object, Destructor destructor) {
+        thread_local std::vector<std::pair<void*, Destructor>> queue;
+        thread_local bool destroying{false};
+
+        if (destroying) {
+            queue.emplace_back(object, destructor);
+            return;
+        }
+
+        destroying = true;
+        destructor(object);
+        while (!queue.empty()) {
+            const auto [queued, queuedDestructor] = queue.back();
+            queue.pop_back();
+            queuedDestructor(queued);
+        }
+        destroying = false;
+    }
+};
+
+/// @brief Owning pointer to an object allocated in an Arena. Must not outlive the arena
+template <typename T>
+using ArenaPtr = std::unique_ptr<T, ArenaDeleter>;
+
+/// @brief Bump allocator for parse-tree nodes
+///
+/// Nodes are placed one after another in big blocks, so nodes built one after another
+/// (e.g. siblings) end up next to each other in memory. Nothing is freed until the whole
+/// arena is destroyed, which releases all the blocks at once
+class Arena {
+   public:
+    static constexpr std::size_t defaultInitialBlockSize{4 * 1024};
+
+    /// @param initialBlockSize size of the first block, next blocks grow geometrically
+    explicit Arena(std::size_t initialBlockSize = defaultInitialBlockSize)
+        : resource_{initialBlockSize, &blocks_} {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /// @brief Constructs a new object in the arena
+    /// @param args passed to the constructor of T
+    /// @return Pointer destroying the object, but not freeing its memory
+    template <typename T, typename... Args>
+    ArenaPtr<T> make(Args&&... args) {
+        void* memory = used_.allocate(sizeof(T), alignof(T));
+        return ArenaPtr<T>(::new (memory) T(std::forward<Args>(args)...));
+    }
+
+    /// @brief Returns the memory resource of the arena, so containers of the nodes can
+    /// allocate their elements in it too
+    std::pmr::memory_resource* getResource() { return &used_; }
+
+    /// @brief Returns the number of bytes in the blocks allocated so far
+    std::size_t getByteSize() const { return blocks_.getByteSize(); }
+
+    /// @brief Returns the number of bytes taken from the blocks so far, not counting
+    /// padding. An arena with a first block of that size would have needed no other
+    std::size_t getUsedSize() const { return used_.getUsedSize(); }
+
+   private:
+    /// @brief Allocates the blocks of the arena on the heap, counting their size
+    class BlockResource : public std::pmr::memory_resource {
+       public:
+        std::size_t getByteSize() const { return byteSize_; }
+
+       private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            byteSize_ += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* block, std::size_t bytes,
+                           std::size_t alignment) override {
+            byteSize_ -= bytes;
+            std::pmr::new_delete_resource()->deallocate(block, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+        std::size_t byteSize_{0};
+    };
+
+    /// @brief Passes allocations on to the blocks, counting their size
+    class UsageResource : public std::pmr::memory_resource {
+       public:
+        explicit UsageResource(std::pmr::memory_resource* upstream)
+            : upstream_(upstream) {}
+
+        std::size_t getUsedSize() const { return usedSize_; }
+
+       private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            usedSize_ += bytes;
+            return upstream_->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* memory, std::size_t bytes,
+                           std::size_t alignment) override {
+            upstream_->deallocate(memory, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+        std::pmr::memory_resource* upstream_;
+        std::size_t usedSize_{0};
+    };
+
+    BlockResource blocks_;
+    std::pmr::monotonic_buffer_resource resource_;
+    UsageResource used_{&resource_};
+};
+
+#endif
@@ -1,13 +1,13 @@
 #ifndef EXPRESSIONS_H
 #define EXPRESSIONS_H
 
-#include <functional>
 #include <memory>
-#include <optional>
+#include <memory_resource>
 #include <string>
 #include <variant>
 #include <vector>
 
+#include "arena.hpp"
 #include "token.hpp"
 #include "types.hpp"
 
@@ -76,12 +76,13 @@ struct Expression {
     virtual void accept(const ExpressionVisitor& vis) const = 0;
 };
 
-using PExpression = std::unique_ptr<Expression>;
+using PExpression = ArenaPtr<Expression>;
+using Expressions = std::pmr::vector<PExpression>;
 
 struct StructInitExpression : public Expression {
-    std::vector<PExpression> exprs;
+    Expressions exprs;
 
-    StructInitExpression(std::vector<PExpression> exprs, Position position)
+    StructInitExpression(Expressions exprs, Position position)
         : Expression{position}, exprs{std::move(exprs)} {}
 
     void accept(const ExpressionVisitor& vis) const override { vis(*this); }
@@ -109,9 +110,6 @@ struct ConjunctionExpression : public BinaryExpression {
 
 struct ComparisonExpression : public BinaryExpression {
     using BinaryExpression::BinaryExpression;
-    using Ctor = std::function<PExpression(PExpression, PExpression, Position)>;
-
-    static std::optional<Ctor> getCtor(Token::Type type);
 };
 
 struct EqualExpression : public ComparisonExpression {
@@ -128,9 +126,6 @@ struct NotEqualExpression : public ComparisonExpression {
 
 struct RelationExpression : public BinaryExpression {
     using BinaryExpression::BinaryExpression;
-    using Ctor = std::function<PExpression(PExpression, PExpression, Position)>;
-
-    static std::optional<Ctor> getCtor(Token::Type type);
 };
 
 struct LessThanExpression : public RelationExpression {
@@ -159,9 +154,6 @@ struct GreaterThanOrEqualExpression : public RelationExpression {
 
 struct AdditiveExpression : public BinaryExpression {
     using BinaryExpression::BinaryExpression;
-    using Ctor = std::function<PExpression(PExpression, PExpression, Position)>;
-
-    static std::optional<Ctor> getCtor(Token::Type type);
 };
 
 struct AdditionExpression : public AdditiveExpression {
@@ -178,9 +170,6 @@ struct SubtractionExpression : public AdditiveExpression {
 
 struct MultiplicativeExpression : public BinaryExpression {
     using BinaryExpression::BinaryExpression;
-    using Ctor = std::function<PExpression(PExpression, PExpression, Position)>;
-
-    static std::optional<Ctor> getCtor(Token::Type type);
 };
 
 struct MultiplicationExpression : public MultiplicativeExpression {
@@ -196,14 +185,10 @@ struct DivisionExpression : public MultiplicativeExpression {
 };
 
 struct NegationExpression : public Expression {
-    using Ctor = std::function<PExpression(PExpression, Position)>;
-
     PExpression expr;
 
     NegationExpression(PExpression expr, Position position)
         : Expression{position}, expr{std::move(expr)} {}
-
-    static std::optional<Ctor> getCtor(Token::Type type);
 };
 
 struct SignChangeExpression : public NegationExpression {
@@ -219,15 +204,11 @@ struct LogicalNegationExpression : public NegationExpression {
 };
 
 struct TypeExpression : public Expression {
-    using Ctor = std::function<PExpression(PExpression, Type, Position)>;
-
     PExpression expr;
     Type type;
 
     TypeExpression(PExpression expr, Type type, Position position)
         : Expression{position}, expr{std::move(expr)}, type{std::move(type)} {}
-
-    static std::optional<Ctor> getCtor(Token::Type type);
 };
 
 struct ConversionExpression : public TypeExpression {
@@ -244,10 +225,10 @@ struct TypeCheckExpression : public TypeExpression {
 
 struct FieldAccessExpression : public Expression {
     PExpression expr;
-    std::string field;
+    Symbol field;
 
-    FieldAccessExpression(PExpression expr, std::string field, Position position)
-        : Expression{position}, expr{std::move(expr)}, field{std::move(field)} {}
+    FieldAccessExpression(PExpression expr, Symbol field, Position position)
+        : Expression{position}, expr{std::move(expr)}, field{field} {}
 
     void accept(const ExpressionVisitor& vis) const override { vis(*this); }
 };
@@ -264,10 +245,10 @@ struct Constant : public Expression {
 };
 
 struct VariableAccess : public Expression {
-    std::string name;
+    Symbol name;
 
-    VariableAccess(std::string name, Position position)
-        : Expression{position}, name{std::move(name)} {}
+    VariableAccess(Symbol name, Position position)
+        : Expression{position}, name{name} {}
 
     void accept(const ExpressionVisitor& vis) const override { vis(*this); }
 };
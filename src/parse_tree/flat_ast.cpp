@@ -0,0 +1,419 @@
+#include "flat_ast.hpp"
+
+#include <bit>
+#include <utility>
+
+#include "magic_enum/magic_enum.hpp"
+#include "printer.hpp"
+
+/// @brief Index of the alternative T in Constant::Value
+template <typename T>
+constexpr std::size_t constantIndex{Constant::Value(T{}).index()};
+
+static_assert(std::variant_size_v<Constant::Value> == 4,
+              "Every alternative of Constant::Value must be decoded by getConstant()");
+
+Constant::Value FlatAst::getConstant(Index node) const {
+    const auto [bits, alternative] = operands_[node];
+    switch (alternative) {
+        case constantIndex<Integral>:
+            return std::bit_cast<Integral>(bits);
+        case constantIndex<Floating>:
+            return std::bit_cast<Floating>(bits);
+        case constantIndex<bool>:
+            return bits != 0;
+        case constantIndex<std::string>:
+            return strings_[bits];
+        default:
+            std::unreachable();
+    }
+}
+
+FlatAst::Function FlatAst::getFunction(Index node) const {
+    const auto& function = functions_[operands_[node].first];
+    return {function.returnType, function.name,
+            {parameters_.data() + function.firstParameter, function.parameterCount}};
+}
+
+std::size_t FlatAst::getByteSize() const {
+    return kinds_.size() * sizeof(NodeKind) + positions_.size() * sizeof(Position)
+           + operands_.size() * sizeof(Operands) + extra_.size() * sizeof(Index)
+           + types_.size() * sizeof(Type) + variables_.size() * sizeof(Variable)
+           + functions_.size() * sizeof(StoredFunction)
+           + parameters_.size() * sizeof(Parameter) + fields_.size() * sizeof(Field)
+           + strings_.size() * sizeof(std::string);
+}
+
+/// @brief Appends the nodes of a parse tree to a FlatAst
+///
+/// Each node is added before its children, so the nodes end up in pre-order
+class FlatAstBuilder : public StatementVisitor, public ExpressionVisitor {
+   public:
+    using Index = FlatAst::Index;
+
+    explicit FlatAstBuilder(FlatAst& ast)
+        : ast_{ast} {}
+
+    Index addStatements(const Statements& statements) {
+        std::vector<Index> nodes;
+        nodes.reserve(statements.size());
+        for (const auto& statement : statements) {
+            // Every statement adds its own node first
+            nodes.push_back(toIndex(ast_.kinds_.size()));
+            statement->accept(*this);
+        }
+        return addList(nodes);
+    }
+
+    void operator()(const IfStatement& stmt) override {
+        addConditional(NodeKind::IF, stmt);
+    }
+
+    void operator()(const WhileStatement& stmt) override {
+        addConditional(NodeKind::WHILE, stmt);
+    }
+
+    void operator()(const ReturnStatement& stmt) override {
+        addOptional(NodeKind::RETURN, stmt.expression, stmt.position);
+    }
+
+    void operator()(const PrintStatement& stmt) override {
+        addOptional(NodeKind::PRINT, stmt.expression, stmt.position);
+    }
+
+    void operator()(const FuncDef& stmt) override {
+        const auto node = addNode(NodeKind::FUNC_DEF, stmt.position);
+        const auto& parameters = stmt.getParameters();
+        ast_.functions_.push_back({stmt.getReturnType(), stmt.getName(),
+                                   toIndex(ast_.parameters_.size()),
+                                   toIndex(parameters.size())});
+        ast_.parameters_.insert(ast_.parameters_.end(), parameters.begin(),
+                                parameters.end());
+        const auto function = toIndex(ast_.functions_.size() - 1);
+        setOperands(node, {function, addStatements(stmt.getStatements())});
+    }
+
+    void operator()(const Assignment& stmt) override {
+        const auto node = addNode(NodeKind::ASSIGNMENT, stmt.position);
+        const auto lhs = addLValue(stmt.lhs, stmt.position);
+        setOperands(node, {lhs, addExpression(*stmt.rhs)});
+    }
+
+    void operator()(const VarDef& stmt) override {
+        const auto kind = stmt.isConst ? NodeKind::CONST_VAR_DEF : NodeKind::VAR_DEF;
+        const auto node = addNode(kind, stmt.position);
+        ast_.variables_.push_back({stmt.type, stmt.name});
+        const auto variable = toIndex(ast_.variables_.size() - 1);
+        setOperands(node, {variable, addExpression(*stmt.expression)});
+    }
+
+    void operator()(const FuncCall& stmt) override { addFuncCall(stmt); }
+
+    void operator()(const StructDef& stmt) override {
+        const auto range = addRange(ast_.fields_, stmt.fields);
+        addNode(NodeKind::STRUCT_DEF, stmt.position, {stmt.name.getId(), range});
+    }
+
+    void operator()(const VariantDef& stmt) override {
+        const auto range = addRange(ast_.types_, stmt.types);
+        addNode(NodeKind::VARIANT_DEF, stmt.position, {stmt.name.getId(), range});
+    }
+
+    void operator()(const StructInitExpression& expr) const override {
+        const auto node = addNode(NodeKind::STRUCT_INIT, expr.position);
+        std::vector<Index> nodes;
+        nodes.reserve(expr.exprs.size());
+        for (const auto& field : expr.exprs)
+            nodes.push_back(addExpression(*field));
+        setOperands(node, {addList(nodes)});
+        result_ = node;
+    }
+
+    void operator()(const DisjunctionExpression& expr) const override {
+        addBinary(NodeKind::DISJUNCTION, expr);
+    }
+
+    void operator()(const ConjunctionExpression& expr) const override {
+        addBinary(NodeKind::CONJUNCTION, expr);
+    }
+
+    void operator()(const EqualExpression& expr) const override {
+        addBinary(NodeKind::EQUAL, expr);
+    }
+
+    void operator()(const NotEqualExpression& expr) const override {
+        addBinary(NodeKind::NOT_EQUAL, expr);
+    }
+
+    void operator()(const LessThanExpression& expr) const override {
+        addBinary(NodeKind::LESS_THAN, expr);
+    }
+
+    void operator()(const LessThanOrEqualExpression& expr) const override {
+        addBinary(NodeKind::LESS_THAN_OR_EQUAL, expr);
+    }
+
+    void operator()(const GreaterThanExpression& expr) const override {
+        addBinary(NodeKind::GREATER_THAN, expr);
+    }
+
+    void operator()(const GreaterThanOrEqualExpression& expr) const override {
+        addBinary(NodeKind::GREATER_THAN_OR_EQUAL, expr);
+    }
+
+    void operator()(const AdditionExpression& expr) const override {
+        addBinary(NodeKind::ADDITION, expr);
+    }
+
+    void operator()(const SubtractionExpression& expr) const override {
+        addBinary(NodeKind::SUBTRACTION, expr);
+    }
+
+    void operator()(const MultiplicationExpression& expr) const override {
+        addBinary(NodeKind::MULTIPLICATION, expr);
+    }
+
+    void operator()(const DivisionExpression& expr) const override {
+        addBinary(NodeKind::DIVISION, expr);
+    }
+
+    void operator()(const SignChangeExpression& expr) const override {
+        addOptional(NodeKind::SIGN_CHANGE, expr.expr, expr.position);
+    }
+
+    void operator()(const LogicalNegationExpression& expr) const override {
+        addOptional(NodeKind::LOGICAL_NEGATION, expr.expr, expr.position);
+    }
+
+    void operator()(const ConversionExpression& expr) const override {
+        addTypeExpression(NodeKind::CONVERSION, expr);
+    }
+
+    void operator()(const TypeCheckExpression& expr) const override {
+        addTypeExpression(NodeKind::TYPE_CHECK, expr);
+    }
+
+    void operator()(const FieldAccessExpression& expr) const override {
+        const auto node = addNode(NodeKind::FIELD_ACCESS, expr.position);
+        setOperands(node, {addExpression(*expr.expr), expr.field.getId()});
+        result_ = node;
+    }
+
+    void operator()(const Constant& expr) const override {
+        const auto bits = std::visit(
+            [this](const auto& value) -> Index {
+                using T = std::decay_t<decltype(value)>;
+                if constexpr (std::is_same_v<T, std::string>) {
+                    ast_.strings_.push_back(value);
+                    return toIndex(ast_.strings_.size() - 1);
+                }
+                else if constexpr (std::is_same_v<T, bool>)
+                    return value;
+                else
+                    return std::bit_cast<Index>(value);
+            },
+            expr.value);
+        result_ = addNode(NodeKind::CONSTANT, expr.position,
+                          {bits, toIndex(expr.value.index())});
+    }
+
+    void operator()(const FuncCall& expr) const override { addFuncCall(expr); }
+
+    void operator()(const VariableAccess& expr) const override {
+        result_ = addNode(NodeKind::VARIABLE_ACCESS, expr.position, {expr.name.getId()});
+    }
+
+   private:
+    static Index toIndex(std::size_t value) { return static_cast<Index>(value); }
+
+    Index addNode(NodeKind kind, Position position,
+                  FlatAst::Operands operands = {}) const {
+        ast_.kinds_.push_back(kind);
+        ast_.positions_.push_back(position);
+        ast_.operands_.push_back(operands);
+        return toIndex(ast_.kinds_.size() - 1);
+    }
+
+    void setOperands(Index node, FlatAst::Operands operands) const {
+        ast_.operands_[node] = operands;
+    }
+
+    Index addExpression(const Expression& expr) const {
+        expr.accept(*this);
+        return result_;
+    }
+
+    Index addList(const std::vector<Index>& nodes) const {
+        const auto list = toIndex(ast_.extra_.size());
+        ast_.extra_.push_back(toIndex(nodes.size()));
+        ast_.extra_.insert(ast_.extra_.end(), nodes.begin(), nodes.end());
+        return list;
+    }
+
+    template <typename T>
+    Index addRange(std::vector<T>& table, const std::pmr::vector<T>& items) const {
+        const auto range = toIndex(ast_.extra_.size());
+        ast_.extra_.push_back(toIndex(table.size()));
+        ast_.extra_.push_back(toIndex(items.size()));
+        table.insert(table.end(), items.begin(), items.end());
+        return range;
+    }
+
+    void addConditional(NodeKind kind, const ConditionalStatement& stmt) {
+        const auto node = addNode(kind, stmt.position);
+        const auto condition = addExpression(*stmt.condition);
+        setOperands(node, {condition, addStatements(stmt.statements)});
+    }
+
+    void addOptional(NodeKind kind, const PExpression& expr, Position position) const {
+        const auto node = addNode(kind, position);
+        if (expr)
+            setOperands(node, {addExpression(*expr)});
+        result_ = node;
+    }
+
+    void addBinary(NodeKind kind, const BinaryExpression& expr) const {
+        const auto node = addNode(kind, expr.position);
+        const auto lhs = addExpression(*expr.lhs);
+        setOperands(node, {lhs, addExpression(*expr.rhs)});
+        result_ = node;
+    }
+
+    void addTypeExpression(NodeKind kind, const TypeExpression& expr) const {
+        const auto node = addNode(kind, expr.position);
+        const auto operand = addExpression(*expr.expr);
+        ast_.types_.push_back(expr.type);
+        setOperands(node, {operand, toIndex(ast_.types_.size() - 1)});
+        result_ = node;
+    }
+
+    void addFuncCall(const FuncCall& call) const {
+        const auto node = addNode(NodeKind::FUNC_CALL, call.Expression::position);
+        std::vector<Index> nodes;
+        nodes.reserve(call.arguments.size());
+        for (const auto& argument : call.arguments) {
+            const auto kind = argument.ref ? NodeKind::REF_ARGUMENT : NodeKind::ARGUMENT;
+            const auto argNode = addNode(kind, argument.position);
+            setOperands(argNode, {addExpression(*argument.value)});
+            nodes.push_back(argNode);
+        }
+        setOperands(node, {call.name.getId(), addList(nodes)});
+        result_ = node;
+    }
+
+    Index addLValue(const LValue& lvalue, Position position) const {
+        if (const auto* name = std::get_if<Symbol>(&lvalue))
+            return addNode(NodeKind::VARIABLE_ACCESS, position, {name->getId()});
+
+        const auto& access = *std::get<ArenaPtr<FieldAccess>>(lvalue);
+        const auto node = addNode(NodeKind::FIELD_ACCESS, position);
+        setOperands(node, {addLValue(access.container, position), access.field.getId()});
+        return node;
+    }
+
+    FlatAst& ast_;
+    // Expression visitors are const, so the index of the last added node is mutable
+    mutable Index result_{FlatAst::none};
+};
+
+FlatAst flatten(const Program& program) {
+    FlatAst ast;
+    ast.statements_ = FlatAstBuilder(ast).addStatements(program.statements);
+    return ast;
+}
+
+/// @brief Prints the node and its children with the given indent
+void printNode(std::ostream& stream, const FlatAst& ast, FlatAst::Index node,
+               unsigned indent);
+
+void printList(std::ostream& stream, const FlatAst& ast, FlatAst::Index list,
+               unsigned indent) {
+    for (const auto child : ast.getList(list))
+        printNode(stream, ast, child, indent);
+}
+
+void printNode(std::ostream& stream, const FlatAst& ast, FlatAst::Index node,
+               unsigned indent) {
+    constexpr unsigned indentWidth{4};
+    const auto kind = ast.getKind(node);
+    const auto [first, second] = ast.getOperands(node);
+    const auto typeName = [](const auto& type) {
+        return std::visit(TypePrinter(), type);
+    };
+
+    stream << std::string(indent, ' ') << magic_enum::enum_name(kind);
+    const auto childIndent = indent + indentWidth;
+
+    switch (kind) {
+        case NodeKind::IF:
+        case NodeKind::WHILE:
+            stream << '\n';
+            printNode(stream, ast, first, childIndent);
+            printList(stream, ast, second, childIndent);
+            break;
+        case NodeKind::FUNC_DEF: {
+            const auto function = ast.getFunction(node);
+            stream << ' ' << function.name;
+            for (const auto& param : function.parameters)
+                stream << ' ' << typeName(param.type) << ' ' << param.name << ',';
+            stream << '\n';
+            printList(stream, ast, second, childIndent);
+            break;
+        }
+        case NodeKind::VAR_DEF:
+        case NodeKind::CONST_VAR_DEF: {
+            const auto& variable = ast.getVariable(node);
+            stream << ' ' << typeName(variable.type) << ' ' << variable.name << '\n';
+            printNode(stream, ast, second, childIndent);
+            break;
+        }
+        case NodeKind::FUNC_CALL:
+            stream << ' ' << FlatAst::getSymbol(first) << '\n';
+            printList(stream, ast, second, childIndent);
+            break;
+        case NodeKind::STRUCT_DEF:
+            stream << ' ' << FlatAst::getSymbol(first);
+            for (const auto& field : ast.getFields(node))
+                stream << ' ' << typeName(field.type) << ' ' << field.name << ',';
+            stream << '\n';
+            break;
+        case NodeKind::VARIANT_DEF:
+            stream << ' ' << FlatAst::getSymbol(first);
+            for (const auto& type : ast.getVariantTypes(node))
+                stream << ' ' << typeName(type) << ',';
+            stream << '\n';
+            break;
+        case NodeKind::STRUCT_INIT:
+            stream << '\n';
+            printList(stream, ast, first, childIndent);
+            break;
+        case NodeKind::CONVERSION:
+        case NodeKind::TYPE_CHECK:
+            stream << ' ' << typeName(ast.getType(second)) << '\n';
+            printNode(stream, ast, first, childIndent);
+            break;
+        case NodeKind::FIELD_ACCESS:
+            stream << ' ' << FlatAst::getSymbol(second) << '\n';
+            printNode(stream, ast, first, childIndent);
+            break;
+        case NodeKind::CONSTANT:
+            std::visit([&](const auto& value) { stream << ' ' << value << '\n'; },
+                       ast.getConstant(node));
+            break;
+        case NodeKind::VARIABLE_ACCESS:
+            stream << ' ' << FlatAst::getSymbol(first) << '\n';
+            break;
+        default:
+            // Nodes with up to two child nodes
+            stream << '\n';
+            for (const auto child : {first, second})
+                if (child != FlatAst::none)
+                    printNode(stream, ast, child, childIndent);
+    }
+}
+
+std::ostream& operator<<(std::ostream& stream, const FlatAst& ast) {
+    for (const auto statement : ast.getStatements())
+        printNode(stream, ast, statement, 0);
+    return stream;
+}
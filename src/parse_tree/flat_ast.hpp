@@ -0,0 +1,167 @@
+#ifndef FLAT_AST_H
+#define FLAT_AST_H
+
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "parse_tree.hpp"
+
+/// @brief Kind of a FlatAst node. The comments list what the two operands of the node
+/// hold
+enum class NodeKind : std::uint8_t {
+    // Statements
+    IF,             ///< condition, statement list
+    WHILE,          ///< condition, statement list
+    RETURN,         ///< expression or none
+    PRINT,          ///< expression or none
+    FUNC_DEF,       ///< function index, statement list
+    ASSIGNMENT,     ///< lvalue (VARIABLE_ACCESS or FIELD_ACCESS), expression
+    VAR_DEF,        ///< variable index, expression
+    CONST_VAR_DEF,  ///< variable index, expression
+    FUNC_CALL,      ///< name, argument list. Also an expression
+    STRUCT_DEF,     ///< name, field range
+    VARIANT_DEF,    ///< name, type range
+
+    // Expressions
+    STRUCT_INIT,            ///< expression list
+    DISJUNCTION,            ///< lhs, rhs
+    CONJUNCTION,            ///< lhs, rhs
+    EQUAL,                  ///< lhs, rhs
+    NOT_EQUAL,              ///< lhs, rhs
+    LESS_THAN,              ///< lhs, rhs
+    LESS_THAN_OR_EQUAL,     ///< lhs, rhs
+    GREATER_THAN,           ///< lhs, rhs
+    GREATER_THAN_OR_EQUAL,  ///< lhs, rhs
+    ADDITION,               ///< lhs, rhs
+    SUBTRACTION,            ///< lhs, rhs
+    MULTIPLICATION,         ///< lhs, rhs
+    DIVISION,               ///< lhs, rhs
+    SIGN_CHANGE,            ///< expression
+    LOGICAL_NEGATION,       ///< expression
+    CONVERSION,             ///< expression, type index
+    TYPE_CHECK,             ///< expression, type index
+    FIELD_ACCESS,           ///< container, field name
+    CONSTANT,               ///< bits of the value or index of the str, alternative index
+    VARIABLE_ACCESS,        ///< name
+
+    ARGUMENT,      ///< expression. Child of FUNC_CALL only
+    REF_ARGUMENT,  ///< expression. Child of FUNC_CALL only
+};
+
+/// @brief Parse tree stored as a struct of arrays
+///
+/// Nodes are indices into parallel arrays of kinds, positions and operands. Operands are
+/// 32-bit indices of child nodes, symbol ids or indices into the side tables (see
+/// NodeKind). Lists of children are stored in one array too, each prefixed by its
+/// length. Nodes are numbered in pre-order, so walking the tree mostly reads the arrays
+/// front to back
+class FlatAst {
+   public:
+    using Index = std::uint32_t;
+    static constexpr Index none{std::numeric_limits<Index>::max()};
+
+    struct Operands {
+        Index first{none};
+        Index second{none};
+    };
+
+    /// @brief Variable definition of a VAR_DEF or CONST_VAR_DEF node
+    struct Variable {
+        Type type;
+        Symbol name;
+    };
+
+    /// @brief Function definition of a FUNC_DEF node
+    struct Function {
+        ReturnType returnType;
+        Symbol name;
+        std::span<const Parameter> parameters;
+    };
+
+    NodeKind getKind(Index node) const { return kinds_[node]; }
+    Position getPosition(Index node) const { return positions_[node]; }
+    const Operands& getOperands(Index node) const { return operands_[node]; }
+    std::size_t getNodeCount() const { return kinds_.size(); }
+
+    /// @brief Returns the top-level statements
+    std::span<const Index> getStatements() const { return getList(statements_); }
+
+    /// @brief Returns the nodes of a list operand
+    std::span<const Index> getList(Index list) const {
+        return {extra_.data() + list + 1, extra_[list]};
+    }
+
+    /// @brief Returns the symbol stored in a name operand
+    static Symbol getSymbol(Index id) { return Symbol::fromId(id); }
+
+    /// @brief Returns the value of a CONSTANT node
+    Constant::Value getConstant(Index node) const;
+
+    /// @brief Returns the type stored in a type index operand
+    const Type& getType(Index type) const { return types_[type]; }
+
+    const Variable& getVariable(Index node) const {
+        return variables_[operands_[node].first];
+    }
+
+    Function getFunction(Index node) const;
+
+    /// @brief Returns the fields of a STRUCT_DEF node
+    std::span<const Field> getFields(Index node) const {
+        return getRange(fields_, operands_[node].second);
+    }
+
+    /// @brief Returns the types of a VARIANT_DEF node
+    std::span<const Type> getVariantTypes(Index node) const {
+        return getRange(types_, operands_[node].second);
+    }
+
+    /// @brief Returns the number of bytes taken by the arrays
+    std::size_t getByteSize() const;
+
+   private:
+    friend class FlatAstBuilder;
+    friend FlatAst flatten(const Program& program);
+
+    /// @brief Function definition as stored in the side table
+    struct StoredFunction {
+        ReturnType returnType;
+        Symbol name;
+        Index firstParameter;
+        Index parameterCount;
+    };
+
+    template <typename T>
+    std::span<const T> getRange(const std::vector<T>& table, Index range) const {
+        return {table.data() + extra_[range], extra_[range + 1]};
+    }
+
+    std::vector<NodeKind> kinds_;
+    std::vector<Position> positions_;
+    std::vector<Operands> operands_;
+
+    std::vector<Index> extra_;
+    std::vector<Type> types_;
+    std::vector<Variable> variables_;
+    std::vector<StoredFunction> functions_;
+    std::vector<Parameter> parameters_;
+    std::vector<Field> fields_;
+    // Values of str constants. Kept out of the SymbolTable, which is never freed
+    std::vector<std::string> strings_;
+
+    Index statements_{0};
+};
+
+/// @brief Converts the parse tree into a FlatAst
+/// @param program
+/// @return Flat tree with the same nodes
+FlatAst flatten(const Program& program);
+
+/// @brief Prints every node on a separate line, indented by its depth
+std::ostream& operator<<(std::ostream& stream, const FlatAst& ast);
+
+#endif
@@ -1,10 +1,32 @@
 #ifndef PARSE_TREE_H
 #define PARSE_TREE_H
 
+#include <memory>
+
+#include "arena.hpp"
 #include "position.hpp"
 #include "statements.hpp"
 
+/// @brief Parse tree of a whole program (or a fragment of it). Owns the arena all its
+/// nodes are allocated in
 struct Program {
+    Program() = default;
+    Program(std::unique_ptr<Arena> arena, Statements statements)
+        : arena{std::move(arena)}, statements{std::move(statements)} {}
+
+    Program(Program&&) = default;
+    Program& operator=(Program&& other) noexcept {
+        // Memberwise assignment would release the arena before destroying the nodes in it
+        if (this != &other) {
+            std::destroy_at(this);
+            std::construct_at(this, std::move(other));
+        }
+        return *this;
+    }
+    ~Program() = default;
+
+    // Declared first, so the nodes are destroyed before their memory is released
+    std::unique_ptr<Arena> arena;
     Statements statements;
 };
 
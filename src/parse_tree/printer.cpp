@@ -203,18 +203,18 @@ void StatementPrinter::operator()(const VariantDef& stmt) {
                   << std::visit(TypePrinter(indent_ + indentWidth_), type) << '\n';
 }
 
-std::string LValuePrinter::operator()(const std::unique_ptr<FieldAccess>& lvalue) const {
+std::string LValuePrinter::operator()(const ArenaPtr<FieldAccess>& lvalue) const {
     return getPrefix() + "FieldAcces\n"
            + std::visit(LValuePrinter(indent_ + indentWidth_), lvalue->container) + '\n'
-           + getPrefix() + "  field: " + lvalue->field;
+           + getPrefix() + "  field: " + std::string(lvalue->field.getName());
 }
 
-std::string LValuePrinter::operator()(const std::string& lvalue) const {
-    return getPrefix() + "variable: " + lvalue;
+std::string LValuePrinter::operator()(Symbol lvalue) const {
+    return getPrefix() + "variable: " + std::string(lvalue.getName());
 }
 
-std::string TypePrinter::operator()(const std::string& type) const {
-    return type;
+std::string TypePrinter::operator()(Symbol type) const {
+    return std::string(type.getName());
 }
 
 std::string TypePrinter::operator()(BuiltInType type) const {
@@ -75,15 +75,15 @@ class LValuePrinter : public BasePrinter {
    public:
     using BasePrinter::BasePrinter;
 
-    std::string operator()(const std::unique_ptr<FieldAccess>& lvalue) const;
-    std::string operator()(const std::string& lvalue) const;
+    std::string operator()(const ArenaPtr<FieldAccess>& lvalue) const;
+    std::string operator()(Symbol lvalue) const;
 };
 
 class TypePrinter : public BasePrinter {
    public:
     using BasePrinter::BasePrinter;
 
-    std::string operator()(const std::string& type) const;
+    std::string operator()(Symbol type) const;
     std::string operator()(BuiltInType type) const;
 };
 
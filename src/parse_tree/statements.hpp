@@ -40,8 +40,8 @@ struct Statement {
     virtual void accept(StatementVisitor& vis) const = 0;
 };
 
-using PStatement = std::unique_ptr<Statement>;
-using Statements = std::vector<PStatement>;
+using PStatement = ArenaPtr<Statement>;
+using Statements = std::pmr::vector<PStatement>;
 
 struct ConditionalStatement : public Statement {
     ConditionalStatement(PExpression condition, Statements statements,
@@ -85,34 +85,34 @@ struct PrintStatement : public Statement {
 };
 
 struct Parameter {
-    Type type{""};
-    std::string name;
+    Type type;
+    Symbol name;
     bool ref{false};
     Position position;
 };
 
-using Parameters = std::vector<Parameter>;
+using Parameters = std::pmr::vector<Parameter>;
 
 class FuncDef : public Statement {
    public:
-    FuncDef(const ReturnType& returnType, const std::string& name,
-            const Parameters& parameters, Statements statements, const Position& position)
+    FuncDef(const ReturnType& returnType, Symbol name, Parameters parameters,
+            Statements statements, const Position& position)
         : Statement{position},
           returnType_{returnType},
           name_{name},
-          parameters_{parameters},
+          parameters_{std::move(parameters)},
           statements_{std::move(statements)} {}
 
     void accept(StatementVisitor& vis) const override { vis(*this); }
 
     const ReturnType& getReturnType() const { return returnType_; }
-    const std::string& getName() const { return name_; }
+    Symbol getName() const { return name_; }
     const Parameters& getParameters() const { return parameters_; }
     const Statements& getStatements() const { return statements_; }
 
    private:
-    ReturnType returnType_{""};
-    std::string name_;
+    ReturnType returnType_;
+    Symbol name_;
     Parameters parameters_;
     Statements statements_;
 };
@@ -120,11 +120,11 @@ class FuncDef : public Statement {
 struct FieldAccess;
 
 /// @brief Left hand side of the assignment statement
-using LValue = std::variant<std::string, std::unique_ptr<FieldAccess>>;
+using LValue = std::variant<Symbol, ArenaPtr<FieldAccess>>;
 
 struct FieldAccess {
     LValue container;
-    std::string field;
+    Symbol field;
 };
 
 struct Assignment : public Statement {
@@ -138,19 +138,19 @@ struct Assignment : public Statement {
 };
 
 struct VarDef : public Statement {
-    VarDef(bool isConst, Type type, std::string name, PExpression expression,
+    VarDef(bool isConst, Type type, Symbol name, PExpression expression,
            const Position& position)
         : Statement{position},
           isConst{isConst},
           type{std::move(type)},
-          name{std::move(name)},
+          name{name},
           expression{std::move(expression)} {}
 
     void accept(StatementVisitor& vis) const override { vis(*this); }
 
     bool isConst;
     Type type;
-    std::string name;
+    Symbol name;
     PExpression expression;
 };
 
@@ -160,16 +160,16 @@ struct Argument {
     Position position;
 };
 
-using Arguments = std::vector<Argument>;
+using Arguments = std::pmr::vector<Argument>;
 
 struct FuncCall : public Expression, public Statement {
-    std::string name;
+    Symbol name;
     Arguments arguments;
 
-    FuncCall(std::string name, Arguments arguments, const Position& position)
+    FuncCall(Symbol name, Arguments arguments, const Position& position)
         : Expression{position},
           Statement{position},
-          name{std::move(name)},
+          name{name},
           arguments{std::move(arguments)} {}
 
     void accept(const ExpressionVisitor& vis) const override { vis(*this); }
@@ -177,28 +177,28 @@ struct FuncCall : public Expression, public Statement {
 };
 
 struct Field {
-    Type type{""};
-    std::string name;
+    Type type;
+    Symbol name;
 };
 
 struct StructDef : public Statement {
-    StructDef(std::string name, std::vector<Field> fields, const Position& position)
-        : Statement{position}, name{std::move(name)}, fields{std::move(fields)} {}
+    StructDef(Symbol name, std::pmr::vector<Field> fields, const Position& position)
+        : Statement{position}, name{name}, fields{std::move(fields)} {}
 
     void accept(StatementVisitor& vis) const override { vis(*this); }
 
-    std::string name;
-    std::vector<Field> fields;
+    Symbol name;
+    std::pmr::vector<Field> fields;
 };
 
 struct VariantDef : public Statement {
-    VariantDef(std::string name, std::vector<Type> types, const Position& position)
-        : Statement{position}, name{std::move(name)}, types{std::move(types)} {}
+    VariantDef(Symbol name, std::pmr::vector<Type> types, const Position& position)
+        : Statement{position}, name{name}, types{std::move(types)} {}
 
     void accept(StatementVisitor& vis) const override { vis(*this); }
 
-    std::string name;
-    std::vector<Type> types;
+    Symbol name;
+    std::pmr::vector<Type> types;
 };
 
 #endif
@@ -0,0 +1,63 @@
+#ifndef BINARY_OPERATORS_H
+#define BINARY_OPERATORS_H
+
+#include <array>
+#include <utility>
+
+#include "magic_enum/magic_enum.hpp"
+#include "parse_tree.hpp"
+#include "token.hpp"
+
+template <typename T>
+PExpression makeBinaryExpression(Arena& arena, PExpression lhs, PExpression rhs,
+                                 Position position) {
+    return arena.make<T>(std::move(lhs), std::move(rhs), position);
+}
+
+/// @brief Binary operator that a token stands for
+struct BinaryOperator {
+    using Ctor = PExpression (*)(Arena&, PExpression, PExpression, Position);
+
+    // Operators with higher precedence bind tighter, 0 if the token is not an operator
+    unsigned precedence{0};
+    Ctor make{nullptr};
+    bool associative{true};
+    const char* missingOperandMessage{nullptr};
+};
+
+/// @brief Binary operators indexed by the type of their token
+inline constexpr auto binaryOperators = [] {
+    std::array<BinaryOperator, magic_enum::enum_count<Token::Type>()> operators{};
+
+    BinaryOperator level;
+    const auto nextLevel = [&](bool associative, const char* missingOperandMessage) {
+        level = {level.precedence + 1, nullptr, associative, missingOperandMessage};
+    };
+    const auto add = [&](Token::Type type, BinaryOperator::Ctor make) {
+        operators[std::to_underlying(type)] = level;
+        operators[std::to_underlying(type)].make = make;
+    };
+
+    // From the loosest to the tightest binding
+    nextLevel(true, "Expected expression after 'or' keyword");
+    add(Token::Type::OR_KW, &makeBinaryExpression<DisjunctionExpression>);
+    nextLevel(true, "Expected expression after 'and' keyword");
+    add(Token::Type::AND_KW, &makeBinaryExpression<ConjunctionExpression>);
+    nextLevel(false, "Expected expression after (not)equal operator");
+    add(Token::Type::EQ_OP, &makeBinaryExpression<EqualExpression>);
+    add(Token::Type::NEQ_OP, &makeBinaryExpression<NotEqualExpression>);
+    nextLevel(false, "Expected expression after relation operator");
+    add(Token::Type::LT_OP, &makeBinaryExpression<LessThanExpression>);
+    add(Token::Type::LTE_OP, &makeBinaryExpression<LessThanOrEqualExpression>);
+    add(Token::Type::GT_OP, &makeBinaryExpression<GreaterThanExpression>);
+    add(Token::Type::GTE_OP, &makeBinaryExpression<GreaterThanOrEqualExpression>);
+    nextLevel(true, "Expected expression after additive operator");
+    add(Token::Type::ADD_OP, &makeBinaryExpression<AdditionExpression>);
+    add(Token::Type::MIN_OP, &makeBinaryExpression<SubtractionExpression>);
+    nextLevel(true, "Expected expression after multiplicative operator");
+    add(Token::Type::MULT_OP, &makeBinaryExpression<MultiplicationExpression>);
+    add(Token::Type::DIV_OP, &makeBinaryExpression<DivisionExpression>);
+    return operators;
+}();
+
+#endif
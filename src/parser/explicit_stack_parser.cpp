@@ -0,0 +1,498 @@
+#include "explicit_stack_parser.hpp"
+
+#include <limits>
+#include <utility>
+
+#include "binary_operators.hpp"
+
+ReturnType typeToReturnType(const Type& type);
+
+const ExplicitStackParser::StatementTasks ExplicitStackParser::statementTasks_ = [] {
+    StatementTasks tasks{};
+    const auto add = [&](Token::Type type, StatementTask task) {
+        tasks[std::to_underlying(type)] = task;
+    };
+    add(Token::Type::IF_KW, &ExplicitStackParser::ifStatement);
+    add(Token::Type::WHILE_KW, &ExplicitStackParser::whileStatement);
+    add(Token::Type::RETURN_KW, &ExplicitStackParser::returnStatement);
+    add(Token::Type::PRINT_KW, &ExplicitStackParser::printStatement);
+    add(Token::Type::CONST_KW, &ExplicitStackParser::constVarDef);
+    add(Token::Type::VOID_KW, &ExplicitStackParser::voidFunc);
+    add(Token::Type::ID, &ExplicitStackParser::defOrAssignment);
+    for (const auto type : {Token::Type::INT_KW, Token::Type::FLOAT_KW,
+                            Token::Type::BOOL_KW, Token::Type::STR_KW})
+        add(type, &ExplicitStackParser::builtInDef);
+    add(Token::Type::STRUCT_KW, &ExplicitStackParser::structDef);
+    add(Token::Type::VARIANT_KW, &ExplicitStackParser::variantDef);
+    return tasks;
+}();
+
+/// STMTS = { STMT }
+ParseTask<Statements> ExplicitStackParser::statements() {
+    Statements statements(parser_.arena_->getResource());
+    while (true) {
+        auto statement = co_await this->statement();
+        if (!statement)
+            break;
+        statements.push_back(std::move(statement));
+    }
+    co_return statements;
+}
+
+/// STMT = IF_STMT
+///      | WHILE_STMT
+///      | RET_STMT
+///      | PRINT_STMT
+///      | CONST_VAR_DEF
+///      | VOID_FUNC
+///      | DEF_OR_ASGN
+///      | BUILT_IN_DEF
+///      | STRUCT_DEF
+///      | VNT_DEF
+ParseTask<PStatement> ExplicitStackParser::statement() {
+    const auto type = parser_.currentToken().getType();
+    const auto task = statementTasks_[std::to_underlying(type)];
+    if (!task)
+        co_return nullptr;
+
+    const Parser::NestingGuard guard(parser_);
+    auto prevPosition = parser_.statementPosition_;
+    parser_.statementPosition_ = parser_.currentToken().getPosition();
+    auto statement = co_await (this->*task)();
+    parser_.statementPosition_ = prevPosition;
+    co_return statement;
+}
+
+/// IF_STMT    = if DISJ '{' STMTS '}'
+/// WHILE_STMT = while DISJ '{' STMTS '}'
+template <typename Conditional>
+ParseTask<PStatement> ExplicitStackParser::conditionalStatement(
+    const char* missingConditionMessage) {
+    parser_.consumeToken();
+
+    auto condition = co_await binaryExpression();
+    if (!condition)
+        throw SyntaxException(parser_.currentToken().getPosition(),
+                              missingConditionMessage);
+
+    parser_.expect(Token::Type::L_C_BR,
+                   SyntaxException(parser_.currentToken().getPosition(),
+                                   "Missing left curly brace"));
+
+    auto statements = co_await this->statements();
+
+    parser_.expect(Token::Type::R_C_BR,
+                   SyntaxException(parser_.currentToken().getPosition(),
+                                   "Missing right curly brace"));
+
+    co_return parser_.arena_->make<Conditional>(
+        std::move(condition), std::move(statements), parser_.statementPosition_);
+}
+
+ParseTask<PStatement> ExplicitStackParser::ifStatement() {
+    return conditionalStatement<IfStatement>("Expected if-statement condition");
+}
+
+ParseTask<PStatement> ExplicitStackParser::whileStatement() {
+    return conditionalStatement<WhileStatement>("Expected while-statement condition");
+}
+
+/// RET_STMT = return [ EXPR ] ';'
+ParseTask<PStatement> ExplicitStackParser::returnStatement() {
+    parser_.consumeToken();
+
+    auto expression = co_await this->expression();
+
+    parser_.expect(Token::Type::SEMI,
+                   SyntaxException(parser_.currentToken().getPosition(),
+                                   "Missing semicolon after return statement"));
+
+    co_return parser_.arena_->make<ReturnStatement>(std::move(expression),
+                                                    parser_.statementPosition_);
+}
+
+/// PRINT_STMT = print [ EXPR ] ';'
+ParseTask<PStatement> ExplicitStackParser::printStatement() {
+    parser_.consumeToken();
+
+    auto expression = co_await this->expression();
+
+    parser_.expect(Token::Type::SEMI,
+                   SyntaxException(parser_.currentToken().getPosition(),
+                                   "Missing semicolon after print statement"));
+
+    co_return parser_.arena_->make<PrintStatement>(std::move(expression),
+                                                   parser_.statementPosition_);
+}
+
+/// CONST_VAR_DEF = const TYPE ID ASGN
+ParseTask<PStatement> ExplicitStackParser::constVarDef() {
+    const auto position = parser_.currentToken().getPosition();
+    parser_.consumeToken();
+
+    const auto type = parser_.getCurrentTokenType();
+    if (!type)
+        throw SyntaxException(parser_.currentToken().getPosition(),
+                              "Expected variable type");
+    parser_.consumeToken();
+
+    auto name = parser_.expectAndReturnValue<Symbol>(
+        Token::Type::ID,
+        SyntaxException(parser_.currentToken().getPosition(), "Expected variable name"));
+
+    auto assignment = co_await this->assignment(name);
+
+    co_return parser_.arena_->make<VarDef>(true, *type, name, std::move(assignment->rhs),
+                                           position);
+}
+
+/// VOID_FUNC = void ID FUNC_DEF
+ParseTask<PStatement> ExplicitStackParser::voidFunc() {
+    parser_.consumeToken();
+
+    const auto name = parser_.expectAndReturnValue<Symbol>(
+        Token::Type::ID,
+        SyntaxException(parser_.currentToken().getPosition(), "Expected function name"));
+
+    co_return co_await funcDef(VoidType(), name);
+}
+
+/// DEF_OR_ASGN = ID ( FIELD_ASGN
+///                  | DEF
+///                  | FUNC_CALL ';' )
+ParseTask<PStatement> ExplicitStackParser::defOrAssignment() {
+    const auto name = std::get<Symbol>(parser_.currentToken().getValue());
+    parser_.consumeToken();
+
+    auto def = co_await this->def(name);
+    if (def)
+        co_return def;
+
+    auto funcCall = co_await this->funcCall(name);
+    if (funcCall) {
+        parser_.expect(Token::Type::SEMI,
+                       SyntaxException(parser_.currentToken().getPosition(),
+                                       "Missing semicolon after function call"));
+        co_return funcCall;
+    }
+    co_return co_await fieldAssignment(name);
+}
+
+/// FIELD_ASGN = { '.' ID } ASGN
+ParseTask<PStatement> ExplicitStackParser::fieldAssignment(Symbol name) {
+    LValue lvalue{name};
+
+    while (parser_.currentToken().getType() == Token::Type::DOT) {
+        parser_.consumeToken();
+
+        auto field = parser_.expectAndReturnValue<Symbol>(
+            Token::Type::ID, SyntaxException(parser_.currentToken().getPosition(),
+                                             "Expected field name after dot operator"));
+
+        lvalue = parser_.arena_->make<FieldAccess>(std::move(lvalue), field);
+    }
+
+    co_return co_await assignment(std::move(lvalue));
+}
+
+/// ASGN = '=' EXPR ';'
+ParseTask<ArenaPtr<Assignment>> ExplicitStackParser::assignment(LValue lvalue) {
+    parser_.expect(Token::Type::ASGN_OP,
+                   SyntaxException(parser_.currentToken().getPosition(),
+                                   "Expected assignment operator"));
+
+    auto expression = co_await this->expression();
+    if (!expression)
+        throw SyntaxException(parser_.currentToken().getPosition(),
+                              "Expected expression after assignment");
+
+    parser_.expect(Token::Type::SEMI,
+                   SyntaxException(parser_.currentToken().getPosition(),
+                                   "Missing semicolon"));
+
+    co_return parser_.arena_->make<Assignment>(std::move(lvalue), std::move(expression),
+                                               parser_.statementPosition_);
+}
+
+/// BUILT_IN_DEF = BUILT_IN_TYPE DEF
+ParseTask<PStatement> ExplicitStackParser::builtInDef() {
+    const auto type = parser_.getCurrentTokenBuiltInType();
+    if (!type)
+        co_return nullptr;
+
+    parser_.consumeToken();
+    co_return co_await def(*type);
+}
+
+/// DEF = ID ( FUNC_DEF | ASGN )
+ParseTask<PStatement> ExplicitStackParser::def(Type type) {
+    if (parser_.currentToken().getType() != Token::Type::ID)
+        co_return nullptr;
+    const auto name = std::get<Symbol>(parser_.currentToken().getValue());
+    parser_.consumeToken();
+
+    auto funcDef = co_await this->funcDef(typeToReturnType(type), name);
+    if (funcDef)
+        co_return funcDef;
+
+    auto assignment = co_await this->assignment(name);
+    co_return parser_.arena_->make<VarDef>(false, type, name, std::move(assignment->rhs),
+                                           parser_.statementPosition_);
+}
+
+/// FUNC_DEF = '(' PARAMS ')' '{' STMTS '}'
+ParseTask<PStatement> ExplicitStackParser::funcDef(ReturnType returnType, Symbol name) {
+    if (parser_.currentToken().getType() != Token::Type::L_PAR)
+        co_return nullptr;
+    parser_.consumeToken();
+
+    auto parameters = parser_.parseList<Parameter>(&Parser::parseParameter);
+
+    parser_.expect(
+        Token::Type::R_PAR,
+        SyntaxException(parser_.currentToken().getPosition(),
+                        "Missing right parenthesis after function parameter list"));
+    parser_.expect(Token::Type::L_C_BR,
+                   SyntaxException(parser_.currentToken().getPosition(),
+                                   "Missing left curly brace before function body"));
+
+    auto statements = co_await this->statements();
+
+    parser_.expect(Token::Type::R_C_BR,
+                   SyntaxException(parser_.currentToken().getPosition(),
+                                   "Missing right curly brace after function body"));
+    co_return parser_.arena_->make<FuncDef>(returnType, name, std::move(parameters),
+                                            std::move(statements),
+                                            parser_.statementPosition_);
+}
+
+/// FUNC_CALL = '(' ARGS ')'
+ParseTask<ArenaPtr<FuncCall>> ExplicitStackParser::funcCall(Symbol name) {
+    if (parser_.currentToken().getType() != Token::Type::L_PAR)
+        co_return nullptr;
+    parser_.consumeToken();
+
+    auto arguments = co_await argumentList();
+
+    parser_.expect(
+        Token::Type::R_PAR,
+        SyntaxException(parser_.currentToken().getPosition(),
+                        "Missing right parenthesis after function call arguments"));
+    co_return parser_.arena_->make<FuncCall>(name, std::move(arguments),
+                                             parser_.statementPosition_);
+}
+
+/// STRUCT_DEF = struct ID '{' FIELDS '}'
+ParseTask<PStatement> ExplicitStackParser::structDef() {
+    co_return parser_.parseStructDef();
+}
+
+/// VNT_DEF = variant ID '{' TYPES '}'
+ParseTask<PStatement> ExplicitStackParser::variantDef() {
+    co_return parser_.parseVariantDef();
+}
+
+/// EXPR = DISJ | STRUCT_INIT
+ParseTask<PExpression> ExplicitStackParser::expression() {
+    const Parser::NestingGuard guard(parser_);
+    if (parser_.currentToken().getType() == Token::Type::L_C_BR)
+        co_return co_await structInitExpression();
+    co_return co_await binaryExpression();
+}
+
+/// STRUCT_INIT = '{' { EXPRS } '}'
+ParseTask<PExpression> ExplicitStackParser::structInitExpression() {
+    const auto position = parser_.currentToken().getPosition();
+    parser_.consumeToken();
+
+    auto exprs = co_await expressionList();
+
+    parser_.expect(
+        Token::Type::R_C_BR,
+        SyntaxException(parser_.currentToken().getPosition(),
+                        "Missing right curly brace at the end of struct initialization"));
+    co_return parser_.arena_->make<StructInitExpression>(std::move(exprs), position);
+}
+
+/// EXPRS = [ EXPR { ',' EXPR } ]
+ParseTask<Expressions> ExplicitStackParser::expressionList() {
+    Expressions exprs(parser_.arena_->getResource());
+
+    auto expr = co_await expression();
+    if (!expr)
+        co_return exprs;
+
+    exprs.push_back(std::move(expr));
+
+    while (parser_.currentToken().getType() == Token::Type::CMA) {
+        parser_.consumeToken();
+        expr = co_await expression();
+        if (!expr)
+            throw SyntaxException(parser_.currentToken().getPosition(),
+                                  "Expected expression after comma");
+        exprs.push_back(std::move(expr));
+    }
+    co_return exprs;
+}
+
+/// See Parser::parseBinaryExpression()
+ParseTask<PExpression> ExplicitStackParser::binaryExpression(unsigned minPrecedence) {
+    const auto position = parser_.currentToken().getPosition();
+    auto lhs = co_await unaryExpression();
+    if (!lhs)
+        co_return nullptr;
+
+    auto maxPrecedence = std::numeric_limits<unsigned>::max();
+
+    while (true) {
+        const auto& op =
+            binaryOperators[std::to_underlying(parser_.currentToken().getType())];
+        if (op.precedence < minPrecedence || op.precedence > maxPrecedence)
+            co_return lhs;
+        parser_.consumeToken();
+
+        auto rhs = co_await binaryExpression(op.precedence + 1u);
+        if (!rhs)
+            throw SyntaxException(parser_.currentToken().getPosition(),
+                                  op.missingOperandMessage);
+        lhs = op.make(*parser_.arena_, std::move(lhs), std::move(rhs), position);
+
+        maxPrecedence = op.associative ? op.precedence : op.precedence - 1u;
+    }
+}
+
+/// FACTOR = [ '-' | not ] UNARY
+/// UNARY  = SRC [ ( as | is ) TYPE ]
+ParseTask<PExpression> ExplicitStackParser::unaryExpression() {
+    const auto position = parser_.currentToken().getPosition();
+    const auto prefix = parser_.currentToken().getType();
+    const bool negated{prefix == Token::Type::MIN_OP || prefix == Token::Type::NOT_KW};
+    if (negated)
+        parser_.consumeToken();
+
+    auto expr = co_await fieldAccessExpression();
+
+    const auto postfix = parser_.currentToken().getType();
+    if (expr && (postfix == Token::Type::AS_KW || postfix == Token::Type::IS_KW)) {
+        const auto typePosition = parser_.currentToken().getPosition();
+        parser_.consumeToken();
+
+        auto type = parser_.getCurrentTokenType();
+        parser_.consumeToken();
+        if (!type)
+            throw SyntaxException(parser_.currentToken().getPosition(),
+                                  "Expected type after is/as keyword");
+
+        if (postfix == Token::Type::AS_KW)
+            expr = parser_.arena_->make<ConversionExpression>(std::move(expr), *type,
+                                                              typePosition);
+        else
+            expr = parser_.arena_->make<TypeCheckExpression>(std::move(expr), *type,
+                                                             typePosition);
+    }
+
+    if (!negated)
+        co_return expr;
+    if (prefix == Token::Type::MIN_OP)
+        co_return parser_.arena_->make<SignChangeExpression>(std::move(expr), position);
+    co_return parser_.arena_->make<LogicalNegationExpression>(std::move(expr), position);
+}
+
+/// SRC = CNTNR { '.' ID }
+ParseTask<PExpression> ExplicitStackParser::fieldAccessExpression() {
+    const auto position = parser_.currentToken().getPosition();
+    auto expr = co_await containerExpression();
+    if (!expr)
+        co_return nullptr;
+
+    while (parser_.currentToken().getType() == Token::Type::DOT) {
+        parser_.consumeToken();
+        auto field = parser_.expectAndReturnValue<Symbol>(
+            Token::Type::ID, SyntaxException(parser_.currentToken().getPosition(),
+                                             "Expected field name after dot operator"));
+        expr = parser_.arena_->make<FieldAccessExpression>(std::move(expr), field,
+                                                           position);
+    }
+
+    co_return expr;
+}
+
+/// CNTNR = '(' EXPR ')'
+///       | CONST
+///       | CALL_OR_VAR
+ParseTask<PExpression> ExplicitStackParser::containerExpression() {
+    if (parser_.currentToken().getType() == Token::Type::L_PAR) {
+        auto expr = co_await nestedExpression();
+        if (expr)
+            co_return expr;
+    }
+    if (auto expr = parser_.parseConstant())
+        co_return expr;
+    co_return co_await variableAccessOrFuncCall();
+}
+
+ParseTask<PExpression> ExplicitStackParser::nestedExpression() {
+    parser_.consumeToken();
+
+    auto expr = co_await expression();
+
+    parser_.expect(Token::Type::R_PAR,
+                   SyntaxException(parser_.currentToken().getPosition(),
+                                   "Expected right parenthesis after nested expression"));
+    co_return expr;
+}
+
+/// CALL_OR_VAR = ID [ '(' ARGS ')' ]
+ParseTask<PExpression> ExplicitStackParser::variableAccessOrFuncCall() {
+    if (parser_.currentToken().getType() != Token::Type::ID)
+        co_return nullptr;
+
+    const auto name = std::get<Symbol>(parser_.currentToken().getValue());
+    const auto position = parser_.currentToken().getPosition();
+    parser_.consumeToken();
+
+    auto funcCall = co_await this->funcCall(name);
+    if (funcCall)
+        co_return funcCall;
+    co_return parser_.arena_->make<VariableAccess>(name, position);
+}
+
+/// ARGS = [ ARG { ',' ARG } ]
+ParseTask<Arguments> ExplicitStackParser::argumentList() {
+    Arguments arguments(parser_.arena_->getResource());
+
+    auto argument = co_await this->argument();
+    if (!argument)
+        co_return arguments;
+
+    arguments.push_back(std::move(*argument));
+
+    while (parser_.currentToken().getType() == Token::Type::CMA) {
+        parser_.consumeToken();
+        argument = co_await this->argument();
+        if (!argument)
+            throw SyntaxException(parser_.currentToken().getPosition(),
+                                  "Expected element after comma");
+        arguments.push_back(std::move(*argument));
+    }
+    co_return arguments;
+}
+
+/// ARG = [ ref ] EXPR
+ParseTask<std::optional<Argument>> ExplicitStackParser::argument() {
+    const bool ref{parser_.currentToken().getType() == Token::Type::REF_KW};
+    if (ref)
+        parser_.consumeToken();
+
+    const auto position = parser_.currentToken().getPosition();
+
+    auto expr = co_await expression();
+    if (!expr) {
+        if (ref)
+            throw SyntaxException(parser_.currentToken().getPosition(),
+                                  "Expected function call argument expression");
+        co_return std::nullopt;
+    }
+
+    co_return Argument{.value = std::move(expr), .ref = ref, .position = position};
+}
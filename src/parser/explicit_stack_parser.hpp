@@ -0,0 +1,67 @@
+#ifndef EXPLICIT_STACK_PARSER_H
+#define EXPLICIT_STACK_PARSER_H
+
+#include <array>
+#include <optional>
+
+#include "parse_task.hpp"
+#include "parser.hpp"
+
+/// @brief Parses the same grammar as the recursive Parser functions and builds the same
+/// tree, but every production is a ParseTask, so nesting is kept on the heap
+///
+/// Shares the tokens, arena and depth limit of the Parser it works for, and calls its
+/// functions for productions that do not nest (e.g. types, parameters, struct
+/// definitions)
+class ExplicitStackParser {
+   public:
+    explicit ExplicitStackParser(Parser& parser)
+        : parser_{parser} {}
+
+    Statements parseStatements() { return statements().run(); }
+    PStatement parseStatement() { return statement().run(); }
+
+   private:
+    using StatementTask = ParseTask<PStatement> (ExplicitStackParser::*)();
+    using StatementTasks =
+        std::array<StatementTask, magic_enum::enum_count<Token::Type>()>;
+
+    /// @brief Task of the statement starting with each token type, null if no
+    /// statement starts with it
+    static const StatementTasks statementTasks_;
+
+    ParseTask<Statements> statements();
+    ParseTask<PStatement> statement();
+    template <typename Conditional>
+    ParseTask<PStatement> conditionalStatement(const char* missingConditionMessage);
+    ParseTask<PStatement> ifStatement();
+    ParseTask<PStatement> whileStatement();
+    ParseTask<PStatement> returnStatement();
+    ParseTask<PStatement> printStatement();
+    ParseTask<PStatement> constVarDef();
+    ParseTask<PStatement> voidFunc();
+    ParseTask<PStatement> defOrAssignment();
+    ParseTask<PStatement> fieldAssignment(Symbol name);
+    ParseTask<ArenaPtr<Assignment>> assignment(LValue lvalue);
+    ParseTask<PStatement> builtInDef();
+    ParseTask<PStatement> def(Type type);
+    ParseTask<PStatement> funcDef(ReturnType returnType, Symbol name);
+    ParseTask<ArenaPtr<FuncCall>> funcCall(Symbol name);
+    ParseTask<PStatement> structDef();
+    ParseTask<PStatement> variantDef();
+    ParseTask<PExpression> expression();
+    ParseTask<PExpression> structInitExpression();
+    ParseTask<Expressions> expressionList();
+    ParseTask<PExpression> binaryExpression(unsigned minPrecedence = 1);
+    ParseTask<PExpression> unaryExpression();
+    ParseTask<PExpression> fieldAccessExpression();
+    ParseTask<PExpression> containerExpression();
+    ParseTask<PExpression> nestedExpression();
+    ParseTask<PExpression> variableAccessOrFuncCall();
+    ParseTask<Arguments> argumentList();
+    ParseTask<std::optional<Argument>> argument();
+
+    Parser& parser_;
+};
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef PARSE_TASK_H
+#define PARSE_TASK_H
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/// @brief Coroutines of the tasks being run, each one awaiting the one above it
+using TaskStack = std::vector<std::coroutine_handle<>>;
+
+/// @brief Coroutine parsing a part of the input
+///
+/// Awaiting a task does not call it. It is pushed onto the TaskStack instead and run()
+/// resumes whichever task is on top, so nested tasks take heap memory rather than
+/// native stack
+template <typename T>
+class ParseTask {
+   public:
+    struct promise_type {
+        ParseTask get_return_object() {
+            return ParseTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        // Move-constructed, so containers keep the allocator of the returned one
+        void return_value(T result) { value.emplace(std::move(result)); }
+
+        // Rethrown in the awaiting task, which unwinds it frame by frame as well
+        void unhandled_exception() { error = std::current_exception(); }
+
+        std::optional<T> value;
+        std::exception_ptr error;
+        TaskStack* stack{nullptr};
+    };
+
+    ParseTask(ParseTask&& other) noexcept
+        : handle_{std::exchange(other.handle_, {})} {}
+    ParseTask& operator=(ParseTask&&) = delete;
+
+    ~ParseTask() {
+        if (handle_)
+            handle_.destroy();
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> awaiting) {
+        handle_.promise().stack = awaiting.promise().stack;
+        handle_.promise().stack->push_back(handle_);
+    }
+
+    T await_resume() {
+        auto& promise = handle_.promise();
+        if (promise.error)
+            std::rethrow_exception(promise.error);
+        return std::move(*promise.value);
+    }
+
+    /// @brief Runs the task together with all the tasks it awaits
+    /// @return Value returned by the task
+    T run() && {
+        TaskStack stack{handle_};
+        handle_.promise().stack = &stack;
+
+        while (!stack.empty()) {
+            // A finished task is popped, so the task awaiting it resumes next
+            if (const auto top = stack.back(); top.done())
+                stack.pop_back();
+            else
+                top.resume();
+        }
+        return await_resume();
+    }
+
+   private:
+    explicit ParseTask(std::coroutine_handle<promise_type> handle)
+        : handle_{handle} {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+#endif
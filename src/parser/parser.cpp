@@ -1,9 +1,15 @@
 #include "parser.hpp"
 
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "binary_operators.hpp"
+#include "explicit_stack_parser.hpp"
 #include "magic_enum/magic_enum.hpp"
 
-std::optional<BuiltInType> Parser::getCurrentTokenBuiltInType() const {
-    auto name = magic_enum::enum_name(currentToken_.getType());
+std::optional<BuiltInType> Parser::getCurrentTokenBuiltInType() {
+    auto name = magic_enum::enum_name(currentToken().getType());
 
     static constexpr std::size_t suffixSize{3};
     if (name.size() < suffixSize)
@@ -13,9 +19,9 @@ std::optional<BuiltInType> Parser::getCurrentTokenBuiltInType() const {
     return magic_enum::enum_cast<BuiltInType>(name);
 }
 
-std::optional<Type> Parser::getCurrentTokenType() const {
-    if (currentToken_.getType() == Token::Type::ID)
-        return std::get<std::string>(currentToken_.getValue());
+std::optional<Type> Parser::getCurrentTokenType() {
+    if (currentToken().getType() == Token::Type::ID)
+        return std::get<Symbol>(currentToken().getValue());
     return getCurrentTokenBuiltInType();
 }
 
@@ -23,21 +29,53 @@ ReturnType typeToReturnType(const Type& type) {
     return std::visit([](auto s) -> ReturnType { return s; }, type);
 }
 
+Parser::NestingGuard::NestingGuard(Parser& parser)
+    : parser_{parser} {
+    if (parser.depth_ == parser.options_.maxDepth)
+        throw SyntaxException(parser.currentToken().getPosition(),
+                              "Blocks or expressions nested too deeply");
+    ++parser.depth_;
+}
+
 /// PROGRAM = STMTS
 Program Parser::parseProgram() {
-    auto statements = parseStatements();
+    auto statements = options_.explicitStack
+                          ? ExplicitStackParser(*this).parseStatements()
+                          : parseStatements();
     expectEndOfFile();
-    return {.statements = std::move(statements)};
+    return {std::exchange(arena_, std::make_unique<Arena>()), std::move(statements)};
+}
+
+Program Parser::parseNextStatement() {
+    auto statement = options_.explicitStack ? ExplicitStackParser(*this).parseStatement()
+                                            : parseStatement();
+    if (!statement) {
+        expectEndOfFile();
+        return {};
+    }
+
+    Statements statements(arena_->getResource());
+    statements.push_back(std::move(statement));
+
+    // Fragments that define something are all kept, so their arenas must not be much
+    // bigger than the statements. Statements in a row tend to be alike (e.g. a run of
+    // function definitions), so the next arena starts with a block the size of this one
+    // plus some slack. Never bigger than it used to be for every fragment
+    const auto used = arena_->getUsedSize();
+    const auto blockSize =
+        std::clamp(used + used / 8, minFragmentBlockSize, Arena::defaultInitialBlockSize);
+    return {std::exchange(arena_, std::make_unique<Arena>(blockSize)),
+            std::move(statements)};
 }
 
-void Parser::expectEndOfFile() const {
-    if (currentToken_.getType() != Token::Type::ETX)
-        throw SyntaxException(currentToken_.getPosition(), "Unknown statement");
+void Parser::expectEndOfFile() {
+    if (currentToken().getType() != Token::Type::ETX)
+        throw SyntaxException(currentToken().getPosition(), "Unknown statement");
 }
 
 /// STMTS = { STMT }
 Statements Parser::parseStatements() {
-    Statements statements;
+    Statements statements(arena_->getResource());
     while (auto statement = parseStatement())
         statements.push_back(std::move(statement));
     return statements;
@@ -54,125 +92,113 @@ Statements Parser::parseStatements() {
 ///      | STRUCT_DEF
 ///      | VNT_DEF
 PStatement Parser::parseStatement() {
-    auto prevPosition = statementPosition_;
-    statementPosition_ = currentToken_.getPosition();
+    // The first token tells the statement apart, only ID-led ones need more lookahead
+    const auto parser = statementParsers_[std::to_underlying(currentToken().getType())];
+    if (!parser)
+        return nullptr;
 
-    for (const auto& parser : statementParsers_) {
-        if (auto statement = parser(*this)) {
-            statementPosition_ = prevPosition;
-            return statement;
-        }
-    }
+    const NestingGuard guard(*this);
+    auto prevPosition = statementPosition_;
+    statementPosition_ = currentToken().getPosition();
+    auto statement = (this->*parser)();
     statementPosition_ = prevPosition;
-    return nullptr;
+    return statement;
 }
 
 /// IF_STMT = if DISJ '{' STMTS '}'
 PStatement Parser::parseIfStatement() {
-    if (currentToken_.getType() != Token::Type::IF_KW)
-        return nullptr;
     consumeToken();
 
-    auto condition = parseDisjunctionExpression();
+    auto condition = parseBinaryExpression();
     if (!condition)
-        throw SyntaxException(currentToken_.getPosition(),
+        throw SyntaxException(currentToken().getPosition(),
                               "Expected if-statement condition");
 
     expect(Token::Type::L_C_BR,
-           SyntaxException(currentToken_.getPosition(), "Missing left curly brace"));
+           SyntaxException(currentToken().getPosition(), "Missing left curly brace"));
 
     auto statements = parseStatements();
 
     expect(Token::Type::R_C_BR,
-           SyntaxException(currentToken_.getPosition(), "Missing right curly brace"));
+           SyntaxException(currentToken().getPosition(), "Missing right curly brace"));
 
-    return std::make_unique<IfStatement>(std::move(condition), std::move(statements),
-                                         statementPosition_);
+    return arena_->make<IfStatement>(std::move(condition), std::move(statements),
+                                     statementPosition_);
 }
 
 /// WHILE_STMT = while DISJ '{' STMTS '}'
 PStatement Parser::parseWhileStatement() {
-    if (currentToken_.getType() != Token::Type::WHILE_KW)
-        return nullptr;
     consumeToken();
 
-    auto condition = parseDisjunctionExpression();
+    auto condition = parseBinaryExpression();
     if (!condition)
-        throw SyntaxException(currentToken_.getPosition(),
+        throw SyntaxException(currentToken().getPosition(),
                               "Expected while-statement condition");
 
     expect(Token::Type::L_C_BR,
-           SyntaxException(currentToken_.getPosition(), "Missing left curly brace"));
+           SyntaxException(currentToken().getPosition(), "Missing left curly brace"));
 
     auto statements = parseStatements();
 
     expect(Token::Type::R_C_BR,
-           SyntaxException(currentToken_.getPosition(), "Missing right curly brace"));
+           SyntaxException(currentToken().getPosition(), "Missing right curly brace"));
 
-    return std::make_unique<WhileStatement>(std::move(condition), std::move(statements),
-                                            statementPosition_);
+    return arena_->make<WhileStatement>(std::move(condition), std::move(statements),
+                                        statementPosition_);
 }
 
 /// RET_STMT = return [ EXPR ] ';'
 PStatement Parser::parseReturnStatement() {
-    if (currentToken_.getType() != Token::Type::RETURN_KW)
-        return nullptr;
     consumeToken();
 
     auto expression = parseExpression();
 
     expect(Token::Type::SEMI,
-           SyntaxException(currentToken_.getPosition(),
+           SyntaxException(currentToken().getPosition(),
                            "Missing semicolon after return statement"));
 
-    return std::make_unique<ReturnStatement>(std::move(expression), statementPosition_);
+    return arena_->make<ReturnStatement>(std::move(expression), statementPosition_);
 }
 
 /// PRINT_STMT = print [ EXPR ] ';'
 PStatement Parser::parsePrintStatement() {
-    if (currentToken_.getType() != Token::Type::PRINT_KW)
-        return nullptr;
     consumeToken();
 
     auto expression = parseExpression();
 
-    expect(Token::Type::SEMI, SyntaxException(currentToken_.getPosition(),
+    expect(Token::Type::SEMI, SyntaxException(currentToken().getPosition(),
                                               "Missing semicolon after print statement"));
 
-    return std::make_unique<PrintStatement>(std::move(expression), statementPosition_);
+    return arena_->make<PrintStatement>(std::move(expression), statementPosition_);
 }
 
 /// CONST_VAR_DEF = const TYPE ID ASGN
 PStatement Parser::parseConstVarDef() {
-    if (currentToken_.getType() != Token::Type::CONST_KW)
-        return nullptr;
-    const auto position = currentToken_.getPosition();
+    const auto position = currentToken().getPosition();
     consumeToken();
 
     const auto type = getCurrentTokenType();
     if (!type)
-        throw SyntaxException(currentToken_.getPosition(), "Expected variable type");
+        throw SyntaxException(currentToken().getPosition(), "Expected variable type");
     consumeToken();
 
-    auto name = expectAndReturnValue<std::string>(
+    auto name = expectAndReturnValue<Symbol>(
         Token::Type::ID,
-        SyntaxException(currentToken_.getPosition(), "Expected variable name"));
+        SyntaxException(currentToken().getPosition(), "Expected variable name"));
 
     auto assignment = parseAssignment(name);
 
-    return std::make_unique<VarDef>(true, *type, std::move(name),
-                                    std::move(assignment->rhs), std::move(position));
+    return arena_->make<VarDef>(true, *type, std::move(name),
+                                std::move(assignment->rhs), std::move(position));
 }
 
 /// VOID_FUNC = void ID FUNC_DEF
 PStatement Parser::parseVoidFunc() {
-    if (currentToken_.getType() != Token::Type::VOID_KW)
-        return nullptr;
     consumeToken();
 
-    const auto name = expectAndReturnValue<std::string>(
+    const auto name = expectAndReturnValue<Symbol>(
         Token::Type::ID,
-        SyntaxException(currentToken_.getPosition(), "Expected function name"));
+        SyntaxException(currentToken().getPosition(), "Expected function name"));
 
     return parseFuncDef(VoidType(), name);
 }
@@ -181,17 +207,14 @@ PStatement Parser::parseVoidFunc() {
 ///                  | DEF
 ///                  | FUNC_CALL ';' )
 PStatement Parser::parseDefOrAssignment() {
-    if (currentToken_.getType() != Token::Type::ID)
-        return nullptr;
-
-    auto name = std::get<std::string>(currentToken_.getValue());
+    auto name = std::get<Symbol>(currentToken().getValue());
     consumeToken();
 
     if (auto def = parseDef(name))
         return def;
     if (auto funcCall = parseFuncCall(name)) {
         expect(Token::Type::SEMI,
-               SyntaxException(currentToken_.getPosition(),
+               SyntaxException(currentToken().getPosition(),
                                "Missing semicolon after function call"));
         return funcCall;
     }
@@ -199,38 +222,37 @@ PStatement Parser::parseDefOrAssignment() {
 }
 
 /// FIELD_ASGN = { '.' ID } ASGN
-PStatement Parser::parseFieldAssignment(const std::string& name) {
+PStatement Parser::parseFieldAssignment(Symbol name) {
     LValue lvalue{name};
 
-    while (currentToken_.getType() == Token::Type::DOT) {
+    while (currentToken().getType() == Token::Type::DOT) {
         consumeToken();
 
-        auto field = expectAndReturnValue<std::string>(
-            Token::Type::ID, SyntaxException(currentToken_.getPosition(),
+        auto field = expectAndReturnValue<Symbol>(
+            Token::Type::ID, SyntaxException(currentToken().getPosition(),
                                              "Expected field name after dot operator"));
 
-        lvalue = std::unique_ptr<FieldAccess>(
-            new FieldAccess{.container = std::move(lvalue), .field = std::move(field)});
+        lvalue = arena_->make<FieldAccess>(std::move(lvalue), field);
     }
 
     return parseAssignment(std::move(lvalue));
 }
 
 /// ASGN = '=' EXPR ';'
-std::unique_ptr<Assignment> Parser::parseAssignment(LValue lvalue) {
+ArenaPtr<Assignment> Parser::parseAssignment(LValue lvalue) {
     expect(Token::Type::ASGN_OP,
-           SyntaxException(currentToken_.getPosition(), "Expected assignment operator"));
+           SyntaxException(currentToken().getPosition(), "Expected assignment operator"));
 
     auto expression = parseExpression();
     if (!expression)
-        throw SyntaxException(currentToken_.getPosition(),
+        throw SyntaxException(currentToken().getPosition(),
                               "Expected expression after assignment");
 
     expect(Token::Type::SEMI,
-           SyntaxException(currentToken_.getPosition(), "Missing semicolon"));
+           SyntaxException(currentToken().getPosition(), "Missing semicolon"));
 
-    return std::make_unique<Assignment>(std::move(lvalue), std::move(expression),
-                                        statementPosition_);
+    return arena_->make<Assignment>(std::move(lvalue), std::move(expression),
+                                    statementPosition_);
 }
 
 /// BUILT_IN_DEF = BUILT_IN_TYPE DEF
@@ -245,128 +267,124 @@ PStatement Parser::parseBuiltInDef() {
 
 /// DEF = ID ( FUNC_DEF | ASGN )
 PStatement Parser::parseDef(const Type& type) {
-    if (currentToken_.getType() != Token::Type::ID)
+    if (currentToken().getType() != Token::Type::ID)
         return nullptr;
-    const auto name = std::get<std::string>(currentToken_.getValue());
+    const auto name = std::get<Symbol>(currentToken().getValue());
     consumeToken();
 
     const auto returnType = typeToReturnType(type);
     if (auto def = parseFuncDef(returnType, name))
         return def;
     auto assignment = parseAssignment(name);
-    return std::make_unique<VarDef>(false, type, std::get<std::string>(assignment->lhs),
-                                    std::move(assignment->rhs), statementPosition_);
+    return arena_->make<VarDef>(false, type, std::get<Symbol>(assignment->lhs),
+                                std::move(assignment->rhs), statementPosition_);
 }
 
 /// FUNC_DEF = '(' PARAMS ')' '{' STMTS '}'
-PStatement Parser::parseFuncDef(const ReturnType& returnType, const std::string& name) {
-    if (currentToken_.getType() != Token::Type::L_PAR)
+PStatement Parser::parseFuncDef(const ReturnType& returnType, Symbol name) {
+    if (currentToken().getType() != Token::Type::L_PAR)
         return nullptr;
     consumeToken();
 
     auto parameters = parseList<Parameter>(&Parser::parseParameter);
 
     expect(Token::Type::R_PAR,
-           SyntaxException(currentToken_.getPosition(),
+           SyntaxException(currentToken().getPosition(),
                            "Missing right parenthesis after function parameter list"));
     expect(Token::Type::L_C_BR,
-           SyntaxException(currentToken_.getPosition(),
+           SyntaxException(currentToken().getPosition(),
                            "Missing left curly brace before function body"));
 
     auto statements = parseStatements();
 
     expect(Token::Type::R_C_BR,
-           SyntaxException(currentToken_.getPosition(),
+           SyntaxException(currentToken().getPosition(),
                            "Missing right curly brace after function body"));
-    return std::make_unique<FuncDef>(returnType, name, std::move(parameters),
-                                     std::move(statements), statementPosition_);
+    return arena_->make<FuncDef>(returnType, name, std::move(parameters),
+                                 std::move(statements), statementPosition_);
 }
 
 /// PARAM = [ ref ] TYPE ID
 std::optional<Parameter> Parser::parseParameter() {
-    const auto position = currentToken_.getPosition();
+    const auto position = currentToken().getPosition();
 
-    const bool ref{currentToken_.getType() == Token::Type::REF_KW};
+    const bool ref{currentToken().getType() == Token::Type::REF_KW};
     if (ref)
         consumeToken();
 
     const auto type = getCurrentTokenType();
     if (!type) {
         if (ref)
-            throw SyntaxException(currentToken_.getPosition(),
+            throw SyntaxException(currentToken().getPosition(),
                                   "Expected parameter type after ref keyword");
         return std::nullopt;
     }
     consumeToken();
 
-    const auto name = expectAndReturnValue<std::string>(
+    const auto name = expectAndReturnValue<Symbol>(
         Token::Type::ID,
-        SyntaxException(currentToken_.getPosition(), "Expected parameter name"));
+        SyntaxException(currentToken().getPosition(), "Expected parameter name"));
 
     return Parameter{.type = *type, .name = name, .ref = ref, .position = position};
 }
 
 /// FUNC_CALL = '(' ARGS ')'
-std::unique_ptr<FuncCall> Parser::parseFuncCall(const std::string& name) {
-    if (currentToken_.getType() != Token::Type::L_PAR)
+ArenaPtr<FuncCall> Parser::parseFuncCall(Symbol name) {
+    if (currentToken().getType() != Token::Type::L_PAR)
         return nullptr;
     consumeToken();
 
     auto arguments = parseList<Argument>(&Parser::parseArgument);
 
     expect(Token::Type::R_PAR,
-           SyntaxException(currentToken_.getPosition(),
+           SyntaxException(currentToken().getPosition(),
                            "Missing right parenthesis after function call arguments"));
-    return std::make_unique<FuncCall>(name, std::move(arguments), statementPosition_);
+    return arena_->make<FuncCall>(name, std::move(arguments), statementPosition_);
 }
 
 /// STRUCT_DEF = struct ID '{' FIELDS '}'
 PStatement Parser::parseStructDef() {
-    if (currentToken_.getType() != Token::Type::STRUCT_KW)
-        return nullptr;
     consumeToken();
 
-    auto name = expectAndReturnValue<std::string>(
+    auto name = expectAndReturnValue<Symbol>(
         Token::Type::ID,
-        SyntaxException(currentToken_.getPosition(), "Expected struct name"));
+        SyntaxException(currentToken().getPosition(), "Expected struct name"));
 
     expect(Token::Type::L_C_BR,
-           SyntaxException(currentToken_.getPosition(),
+           SyntaxException(currentToken().getPosition(),
                            "Missing left curly brace in struct difinition"));
 
     auto fields = parseList<Field>(&Parser::parseField);
 
     expect(Token::Type::R_C_BR,
-           SyntaxException(currentToken_.getPosition(),
+           SyntaxException(currentToken().getPosition(),
                            "Missing right curly brace in struct difinition"));
-    return std::make_unique<StructDef>(std::move(name), std::move(fields),
-                                       statementPosition_);
+    return arena_->make<StructDef>(std::move(name), std::move(fields),
+                                   statementPosition_);
 }
 
 /// VNT_DEF = variant ID '{' TYPES '}'
 PStatement Parser::parseVariantDef() {
-    if (currentToken_.getType() != Token::Type::VARIANT_KW)
-        return nullptr;
     consumeToken();
 
-    auto name = expectAndReturnValue<std::string>(
+    auto name = expectAndReturnValue<Symbol>(
         Token::Type::ID,
-        SyntaxException(currentToken_.getPosition(), "Expected variant name"));
+        SyntaxException(currentToken().getPosition(), "Expected variant name"));
 
     expect(Token::Type::L_C_BR,
-           SyntaxException(currentToken_.getPosition(),
+           SyntaxException(currentToken().getPosition(),
                            "Missing left curly brace in variant difinition"));
 
     auto types = parseList<Type>(&Parser::parseType);
     if (types.empty())
-        throw NoTypesInVariant{currentToken_.getPosition()};
+        throw NoTypesInVariant{currentToken().getPosition()};
 
     expect(Token::Type::R_C_BR,
-           SyntaxException(currentToken_.getPosition(),
+           SyntaxException(currentToken().getPosition(),
                            "Missing right curly brace in variant difinition"));
 
-    return std::make_unique<VariantDef>(std::move(name), std::move(types),
-                                        statementPosition_);
+    return arena_->make<VariantDef>(std::move(name), std::move(types),
+                                    statementPosition_);
 }
 
 std::optional<Type> Parser::parseType() {
@@ -384,39 +402,40 @@ std::optional<Field> Parser::parseField() {
         return std::nullopt;
     consumeToken();
 
-    auto name = expectAndReturnValue<std::string>(
+    auto name = expectAndReturnValue<Symbol>(
         Token::Type::ID,
-        SyntaxException(currentToken_.getPosition(), "Expected field name"));
+        SyntaxException(currentToken().getPosition(), "Expected field name"));
 
     return Field{.type = *type, .name = std::move(name)};
 }
 
 /// EXPR = DISJ | STRUCT_INIT
 PExpression Parser::parseExpression() {
+    const NestingGuard guard(*this);
     if (auto expr = parseStructInitExpression())
         return expr;
-    return parseDisjunctionExpression();
+    return parseBinaryExpression();
 }
 
 /// STRUCT_INIT = '{' { EXPRS } '}'
 PExpression Parser::parseStructInitExpression() {
-    if (currentToken_.getType() != Token::Type::L_C_BR)
+    if (currentToken().getType() != Token::Type::L_C_BR)
         return nullptr;
-    const auto position = currentToken_.getPosition();
+    const auto position = currentToken().getPosition();
     consumeToken();
 
     auto exprs = parseExpressionList();
 
     expect(
         Token::Type::R_C_BR,
-        SyntaxException(currentToken_.getPosition(),
+        SyntaxException(currentToken().getPosition(),
                         "Missing right curly brace at the end of struct initialization"));
-    return std::make_unique<StructInitExpression>(std::move(exprs), position);
+    return arena_->make<StructInitExpression>(std::move(exprs), position);
 }
 
 /// EXPRS = [ EXPR { ',' EXPR } ]
-std::vector<PExpression> Parser::parseExpressionList() {
-    std::vector<PExpression> exprs;
+Expressions Parser::parseExpressionList() {
+    Expressions exprs(arena_->getResource());
 
     auto expr = parseExpression();
     if (!expr)
@@ -424,11 +443,11 @@ std::vector<PExpression> Parser::parseExpressionList() {
 
     exprs.push_back(std::move(expr));
 
-    while (currentToken_.getType() == Token::Type::CMA) {
+    while (currentToken().getType() == Token::Type::CMA) {
         consumeToken();
         expr = parseExpression();
         if (!expr)
-            throw SyntaxException(currentToken_.getPosition(),
+            throw SyntaxException(currentToken().getPosition(),
                                   "Expected expression after comma");
         exprs.push_back(std::move(expr));
     }
@@ -436,179 +455,90 @@ std::vector<PExpression> Parser::parseExpressionList() {
 }
 
 /// DISJ = CONJ { or CONJ }
-PExpression Parser::parseDisjunctionExpression() {
-    const auto position = currentToken_.getPosition();
-    PExpression leftLogicFactor = parseConjunctionExpression();
-    if (!leftLogicFactor)
-        return nullptr;
-
-    while (currentToken_.getType() == Token::Type::OR_KW) {
-        consumeToken();
-        auto rightLogicFactor = parseConjunctionExpression();
-        if (!rightLogicFactor)
-            throw SyntaxException(currentToken_.getPosition(),
-                                  "Expected expression after 'or' keyword");
-        leftLogicFactor = std::make_unique<DisjunctionExpression>(
-            std::move(leftLogicFactor), std::move(rightLogicFactor), position);
-    }
-
-    return leftLogicFactor;
-}
-
 /// CONJ = EQ { and EQ }
-PExpression Parser::parseConjunctionExpression() {
-    const auto position = currentToken_.getPosition();
-    auto leftLogicFactor = parseEqualExpression();
-    if (!leftLogicFactor)
+/// EQ   = REL [ ( '==' | '!=' ) REL ]
+/// REL  = ADD [ ( '<' | '>' | '<=' | '>=' ) ADD ]
+/// ADD  = TERM { ( '+' | '-' ) TERM }
+/// TERM = FACTOR { ( '*' | '/' ) FACTOR }
+///
+/// Parsed by precedence climbing: operators binding tighter than minPrecedence are left
+/// to the caller
+PExpression Parser::parseBinaryExpression(unsigned minPrecedence) {
+    const auto position = currentToken().getPosition();
+    auto lhs = parseUnaryExpression();
+    if (!lhs)
         return nullptr;
 
-    while (currentToken_.getType() == Token::Type::AND_KW) {
-        consumeToken();
-        auto rightLogicFactor = parseEqualExpression();
-        if (!rightLogicFactor)
-            throw SyntaxException(currentToken_.getPosition(),
-                                  "Expected expression after 'and' keyword");
-        leftLogicFactor = std::make_unique<ConjunctionExpression>(
-            std::move(leftLogicFactor), std::move(rightLogicFactor), position);
-    }
+    // Non-associative operators cannot be followed by another one of the same
+    // precedence, and neither by a tighter one left over by the right operand
+    auto maxPrecedence = std::numeric_limits<unsigned>::max();
 
-    return leftLogicFactor;
-}
-
-/// EQ = REL [ '==' REL ]
-///    | REL [ '!=' REL ]
-PExpression Parser::parseEqualExpression() {
-    const auto position = currentToken_.getPosition();
-    auto leftEqFactor = parseRelExpression();
-    if (!leftEqFactor)
-        return nullptr;
-
-    if (const auto& ctor = ComparisonExpression::getCtor(currentToken_.getType())) {
-        consumeToken();
-        auto rightEqFactor = parseRelExpression();
-        if (!rightEqFactor)
-            throw SyntaxException(currentToken_.getPosition(),
-                                  "Expected expression after (not)equal operator");
-        leftEqFactor =
-            (*ctor)(std::move(leftEqFactor), std::move(rightEqFactor), position);
-    }
-
-    return leftEqFactor;
-}
-
-/// REL = ADD [ '<' ADD ]
-///     | ADD [ '>' ADD ]
-///     | ADD [ '<=' ADD ]
-///     | ADD [ '>=' ADD ]
-PExpression Parser::parseRelExpression() {
-    const auto position = currentToken_.getPosition();
-    auto leftRelFactor = parseAdditiveExpression();
-    if (!leftRelFactor)
-        return nullptr;
-
-    if (const auto& ctor = RelationExpression::getCtor(currentToken_.getType())) {
-        consumeToken();
-        auto rightRelFactor = parseAdditiveExpression();
-        if (!rightRelFactor)
-            throw SyntaxException(currentToken_.getPosition(),
-                                  "Expected expression after relation operator");
-        leftRelFactor =
-            (*ctor)(std::move(leftRelFactor), std::move(rightRelFactor), position);
-    }
-
-    return leftRelFactor;
-}
-
-/// ADD = TERM { '+' TERM }
-///     | TERM { '-' TERM }
-PExpression Parser::parseAdditiveExpression() {
-    const auto position = currentToken_.getPosition();
-    auto leftTerm = parseMultiplicativeExpression();
-    if (!leftTerm)
-        return nullptr;
-
-    while (const auto& ctor = AdditionExpression::getCtor(currentToken_.getType())) {
+    while (true) {
+        const auto& op = binaryOperators[std::to_underlying(currentToken().getType())];
+        if (op.precedence < minPrecedence || op.precedence > maxPrecedence)
+            return lhs;
         consumeToken();
-        auto rightTerm = parseMultiplicativeExpression();
-        if (!rightTerm)
-            throw SyntaxException(currentToken_.getPosition(),
-                                  "Expected expression after additive operator");
-        leftTerm = (*ctor)(std::move(leftTerm), std::move(rightTerm), position);
-    }
 
-    return leftTerm;
-}
-
-/// TERM = FACTOR { '*' FACTOR }
-///      | FACTOR { '/' FACTOR }
-PExpression Parser::parseMultiplicativeExpression() {
-    const auto position = currentToken_.getPosition();
-    auto leftFactor = parseNegationExpression();
-    if (!leftFactor)
-        return nullptr;
+        auto rhs = parseBinaryExpression(op.precedence + 1u);
+        if (!rhs)
+            throw SyntaxException(currentToken().getPosition(), op.missingOperandMessage);
+        lhs = op.make(*arena_, std::move(lhs), std::move(rhs), position);
 
-    while (const auto& ctor =
-               MultiplicativeExpression::getCtor(currentToken_.getType())) {
-        consumeToken();
-        auto rightFactor = parseNegationExpression();
-        if (!rightFactor)
-            throw SyntaxException(currentToken_.getPosition(),
-                                  "Expected expression after multiplicative operator");
-        leftFactor = (*ctor)(std::move(leftFactor), std::move(rightFactor), position);
+        maxPrecedence = op.associative ? op.precedence : op.precedence - 1u;
     }
-
-    return leftFactor;
 }
 
 /// FACTOR = [ '-' | not ] UNARY
-PExpression Parser::parseNegationExpression() {
-    const auto position = currentToken_.getPosition();
-    const auto& ctor = NegationExpression::getCtor(currentToken_.getType());
-    if (ctor)
+/// UNARY  = SRC [ ( as | is ) TYPE ]
+PExpression Parser::parseUnaryExpression() {
+    const auto position = currentToken().getPosition();
+    const auto prefix = currentToken().getType();
+    const bool negated{prefix == Token::Type::MIN_OP || prefix == Token::Type::NOT_KW};
+    if (negated)
         consumeToken();
 
-    auto expr = parseTypeExpression();
-    if (ctor)
-        return (*ctor)(std::move(expr), position);
-    return expr;
-}
-
-/// UNARY = SRC [ as TYPE ]
-///       | SRC [ is TYPE ]
-PExpression Parser::parseTypeExpression() {
     auto expr = parseFieldAccessExpression();
-    if (!expr)
-        return nullptr;
 
-    if (const auto& ctor = TypeExpression::getCtor(currentToken_.getType())) {
-        const auto position = currentToken_.getPosition();
+    const auto postfix = currentToken().getType();
+    if (expr && (postfix == Token::Type::AS_KW || postfix == Token::Type::IS_KW)) {
+        const auto typePosition = currentToken().getPosition();
         consumeToken();
 
         auto type = getCurrentTokenType();
         consumeToken();
         if (!type)
-            throw SyntaxException(currentToken_.getPosition(),
+            throw SyntaxException(currentToken().getPosition(),
                                   "Expected type after is/as keyword");
 
-        expr = (*ctor)(std::move(expr), *type, position);
+        if (postfix == Token::Type::AS_KW)
+            expr = arena_->make<ConversionExpression>(std::move(expr), *type,
+                                                      typePosition);
+        else
+            expr = arena_->make<TypeCheckExpression>(std::move(expr), *type,
+                                                     typePosition);
     }
-    return expr;
+
+    if (!negated)
+        return expr;
+    if (prefix == Token::Type::MIN_OP)
+        return arena_->make<SignChangeExpression>(std::move(expr), position);
+    return arena_->make<LogicalNegationExpression>(std::move(expr), position);
 }
 
 /// SRC = CNTNR { '.' ID }
 PExpression Parser::parseFieldAccessExpression() {
-    const auto position = currentToken_.getPosition();
+    const auto position = currentToken().getPosition();
     auto expr = parseContainerExpression();
     if (!expr)
         return nullptr;
 
-    while (currentToken_.getType() == Token::Type::DOT) {
+    while (currentToken().getType() == Token::Type::DOT) {
         consumeToken();
-        auto field = expectAndReturnValue<std::string>(
-            Token::Type::ID, SyntaxException(currentToken_.getPosition(),
+        auto field = expectAndReturnValue<Symbol>(
+            Token::Type::ID, SyntaxException(currentToken().getPosition(),
                                              "Expected field name after dot operator"));
-        expr = std::make_unique<FieldAccessExpression>(std::move(expr), std::move(field),
-                                                       position);
+        expr = arena_->make<FieldAccessExpression>(std::move(expr), std::move(field),
+                                                   position);
     }
 
     return expr;
@@ -626,14 +556,14 @@ PExpression Parser::parseContainerExpression() {
 }
 
 PExpression Parser::parseNestedExpression() {
-    if (currentToken_.getType() != Token::Type::L_PAR)
+    if (currentToken().getType() != Token::Type::L_PAR)
         return nullptr;
     consumeToken();
 
     auto expr = parseExpression();
 
     expect(Token::Type::R_PAR,
-           SyntaxException(currentToken_.getPosition(),
+           SyntaxException(currentToken().getPosition(),
                            "Expected right parenthesis after nested expression"));
     return expr;
 }
@@ -642,45 +572,52 @@ struct TokenValueToConstantValue {
     Constant::Value operator()(const std::monostate&) const {
         throw std::runtime_error("Expected token to have value");
     }
+    Constant::Value operator()(Symbol) const {
+        throw std::runtime_error("Expected token to be a constant");
+    }
     Constant::Value operator()(const auto& v) const { return v; }
 };
 
 PExpression Parser::parseConstant() {
-    if (!currentToken_.isConstant())
+    if (!currentToken().isConstant())
         return nullptr;
 
-    const auto value = std::visit(TokenValueToConstantValue(), currentToken_.getValue());
-    const auto position = currentToken_.getPosition();
+    // Str literals have no value, only the lexer knows their text
+    const auto value = currentToken().getType() == Token::Type::STR_CONST
+                           ? Constant::Value(lexer_.getText(currentToken()))
+                           : std::visit(TokenValueToConstantValue(),
+                                        currentToken().getValue());
+    const auto position = currentToken().getPosition();
     consumeToken();
-    return std::make_unique<Constant>(value, position);
+    return arena_->make<Constant>(value, position);
 }
 
 /// CALL_OR_VAR = ID [ '(' ARGS ')' ]
 PExpression Parser::parseVariableAccessOrFuncCall() {
-    if (currentToken_.getType() != Token::Type::ID)
+    if (currentToken().getType() != Token::Type::ID)
         return nullptr;
 
-    const auto name = std::get<std::string>(currentToken_.getValue());
-    auto position = currentToken_.getPosition();
+    const auto name = std::get<Symbol>(currentToken().getValue());
+    auto position = currentToken().getPosition();
     consumeToken();
 
     if (auto funcCall = parseFuncCall(name))
         return funcCall;
-    return std::make_unique<VariableAccess>(name, std::move(position));
+    return arena_->make<VariableAccess>(name, std::move(position));
 }
 
 /// ARG = [ ref ] EXPR
 std::optional<Argument> Parser::parseArgument() {
-    const bool ref{currentToken_.getType() == Token::Type::REF_KW};
+    const bool ref{currentToken().getType() == Token::Type::REF_KW};
     if (ref)
         consumeToken();
 
-    auto argPosition = currentToken_.getPosition();
+    auto argPosition = currentToken().getPosition();
 
     auto expr = parseExpression();
     if (!expr) {
         if (ref)
-            throw SyntaxException(currentToken_.getPosition(),
+            throw SyntaxException(currentToken().getPosition(),
                                   "Expected function call argument expression");
         return std::nullopt;
     }
@@ -689,15 +626,22 @@ std::optional<Argument> Parser::parseArgument() {
         .value = std::move(expr), .ref = ref, .position = std::move(argPosition)};
 }
 
-Parser::StatementParsers Parser::statementParsers_{
-    [](Parser& p) { return p.parseIfStatement(); },
-    [](Parser& p) { return p.parseWhileStatement(); },
-    [](Parser& p) { return p.parseReturnStatement(); },
-    [](Parser& p) { return p.parsePrintStatement(); },
-    [](Parser& p) { return p.parseConstVarDef(); },
-    [](Parser& p) { return p.parseVoidFunc(); },
-    [](Parser& p) { return p.parseDefOrAssignment(); },
-    [](Parser& p) { return p.parseBuiltInDef(); },
-    [](Parser& p) { return p.parseStructDef(); },
-    [](Parser& p) { return p.parseVariantDef(); },
-};
+const Parser::StatementParsers Parser::statementParsers_ = [] {
+    StatementParsers parsers{};
+    const auto add = [&](Token::Type type, StatementParser parser) {
+        parsers[std::to_underlying(type)] = parser;
+    };
+    add(Token::Type::IF_KW, &Parser::parseIfStatement);
+    add(Token::Type::WHILE_KW, &Parser::parseWhileStatement);
+    add(Token::Type::RETURN_KW, &Parser::parseReturnStatement);
+    add(Token::Type::PRINT_KW, &Parser::parsePrintStatement);
+    add(Token::Type::CONST_KW, &Parser::parseConstVarDef);
+    add(Token::Type::VOID_KW, &Parser::parseVoidFunc);
+    add(Token::Type::ID, &Parser::parseDefOrAssignment);
+    for (const auto type : {Token::Type::INT_KW, Token::Type::FLOAT_KW,
+                            Token::Type::BOOL_KW, Token::Type::STR_KW})
+        add(type, &Parser::parseBuiltInDef);
+    add(Token::Type::STRUCT_KW, &Parser::parseStructDef);
+    add(Token::Type::VARIANT_KW, &Parser::parseVariantDef);
+    return parsers;
+}();
@@ -1,31 +1,97 @@
 #ifndef PARSER_H
 #define PARSER_H
 
+#include <array>
 #include <functional>
+#include <memory>
 #include <optional>
+#include <vector>
 
 #include "ILexer.hpp"
+#include "magic_enum/magic_enum.hpp"
 #include "parse_tree.hpp"
 #include "parser_errors.hpp"
 #include "token.hpp"
 
+/// @brief How deeply nested input the parser accepts and how it keeps track of it
+struct ParserOptions {
+    static constexpr std::size_t defaultMaxDepth{1000};
+
+    /// @brief Keeps the productions being parsed on the heap instead of the native stack,
+    /// so the nesting depth is limited only by memory and maxDepth. Slower, hence off by
+    /// default
+    ///
+    /// The tree is destroyed without recursion too, but the interpreter, flatten() and
+    /// the printer still walk it recursively. Trees nested deeper than defaultMaxDepth
+    /// are only safe to build and destroy, e.g. for tools checking the syntax
+    bool explicitStack{false};
+
+    /// @brief Deepest nesting of blocks and expressions parsed before throwing
+    /// SyntaxException. The default fits the native stack of the recursive parser and
+    /// of the interpreter walking the tree
+    std::size_t maxDepth{defaultMaxDepth};
+};
+
 /// @brief Parser building parse tree from tokens
+///
+/// Every production that nests (statements, blocks, expressions) has a copy in
+/// ExplicitStackParser, used in the explicit-stack mode. The grammar is changed in both
+/// places, and explicit_stack_builds_same_tree in tests/test_nesting.cpp checks that the
+/// two parsers build the same trees. Productions that do not nest are shared
 class Parser {
    public:
-    explicit Parser(ILexer& lexer)
-        : lexer_(lexer) {
+    explicit Parser(ILexer& lexer, ParserOptions options = {})
+        : lexer_(lexer), tokens_(tokenBufferSize), options_(options) {
         consumeToken();
     }
 
     /// @brief Builds parse tree from token acquired from lexer
-    /// @return Parse tree
+    /// @return Parse tree, with all nodes allocated in its arena
     Program parseProgram();
 
-    const Token& getCurrentToken() { return currentToken_; }
+    /// @brief Builds the next top-level statement, so the program can be processed one
+    /// statement at a time
+    /// @return Program fragment with the statement and its own arena, or with no
+    /// statements once the end of text is reached
+    Program parseNextStatement();
+
+    const Token& getCurrentToken() { return currentToken(); }
 
    private:
-    void consumeToken() { currentToken_ = lexer_.getToken(); };
-    void expectEndOfFile() const;
+    friend class ExplicitStackParser;
+
+    /// @brief Counts one level of nesting for as long as it lives
+    class NestingGuard {
+       public:
+        explicit NestingGuard(Parser& parser);
+        ~NestingGuard() { --parser_.depth_; }
+
+        NestingGuard(const NestingGuard&) = delete;
+        NestingGuard& operator=(const NestingGuard&) = delete;
+
+       private:
+        Parser& parser_;
+    };
+
+    /// @brief Takes the next token from the buffer. Once it is used up, it is refilled
+    /// from the lexer in bulk, but only when the token is needed. So a statement is
+    /// complete without waiting for the input that follows it
+    void consumeToken() {
+        if (nextToken_ == tokenCount_)
+            refillPending_ = true;
+        else
+            currentToken_ = tokens_[nextToken_++];
+    }
+    const Token& currentToken() {
+        if (refillPending_) {
+            tokenCount_ = lexer_.getTokens(tokens_);
+            nextToken_ = 0;
+            refillPending_ = false;
+            currentToken_ = tokens_[nextToken_++];
+        }
+        return currentToken_;
+    }
+    void expectEndOfFile();
 
     template <typename Exception>
     void expect(Token::Type expected, const Exception& exception);
@@ -33,11 +99,12 @@ class Parser {
     template <typename T, typename Exception>
     T expectAndReturnValue(Token::Type expected, const Exception& exception);
 
-    std::optional<BuiltInType> getCurrentTokenBuiltInType() const;
-    std::optional<Type> getCurrentTokenType() const;
+    std::optional<BuiltInType> getCurrentTokenBuiltInType();
+    std::optional<Type> getCurrentTokenType();
 
     Statements parseStatements();
     PStatement parseStatement();
+    // Called through statementParsers_, so the first token is known to match
     PStatement parseIfStatement();
     PStatement parseWhileStatement();
     PStatement parseReturnStatement();
@@ -45,27 +112,21 @@ class Parser {
     PStatement parseConstVarDef();
     PStatement parseVoidFunc();
     PStatement parseDefOrAssignment();
-    PStatement parseFieldAssignment(const std::string& name);
-    std::unique_ptr<Assignment> parseAssignment(LValue lvalue);
+    PStatement parseFieldAssignment(Symbol name);
+    ArenaPtr<Assignment> parseAssignment(LValue lvalue);
     PStatement parseBuiltInDef();
     PStatement parseDef(const Type& type);
-    PStatement parseFuncDef(const ReturnType& returnType, const std::string& name);
+    PStatement parseFuncDef(const ReturnType& returnType, Symbol name);
     std::optional<Parameter> parseParameter();
-    std::unique_ptr<FuncCall> parseFuncCall(const std::string& name);
+    ArenaPtr<FuncCall> parseFuncCall(Symbol name);
     PStatement parseStructDef();
     std::optional<Field> parseField();
     PStatement parseVariantDef();
     std::optional<Type> parseType();
     PExpression parseExpression();
     PExpression parseStructInitExpression();
-    PExpression parseDisjunctionExpression();
-    PExpression parseConjunctionExpression();
-    PExpression parseEqualExpression();
-    PExpression parseRelExpression();
-    PExpression parseAdditiveExpression();
-    PExpression parseMultiplicativeExpression();
-    PExpression parseNegationExpression();
-    PExpression parseTypeExpression();
+    PExpression parseBinaryExpression(unsigned minPrecedence = 1);
+    PExpression parseUnaryExpression();
     PExpression parseFieldAccessExpression();
     PExpression parseContainerExpression();
     PExpression parseNestedExpression();
@@ -74,15 +135,36 @@ class Parser {
     std::optional<Argument> parseArgument();
 
     template <typename T, typename ElementParser>
-    std::vector<T> parseList(ElementParser elementParser);
-    std::vector<PExpression> parseExpressionList();
+    std::pmr::vector<T> parseList(ElementParser elementParser);
+    Expressions parseExpressionList();
+
+    using StatementParser = PStatement (Parser::*)();
+    using StatementParsers =
+        std::array<StatementParser, magic_enum::enum_count<Token::Type>()>;
 
-    using StatementParsers = std::initializer_list<std::function<PStatement(Parser&)>>;
-    static StatementParsers statementParsers_;
+    /// @brief Parser of the statement starting with each token type, null if no
+    /// statement starts with it
+    static const StatementParsers statementParsers_;
+
+    static constexpr std::size_t tokenBufferSize{256};
+    /// @brief Size of the first block of the arena of a statement parsed on its own,
+    /// unless the previous one needed more
+    static constexpr std::size_t minFragmentBlockSize{512};
 
     ILexer& lexer_;
+    std::vector<Token> tokens_;
+    std::size_t tokenCount_{0};
+    std::size_t nextToken_{0};
     Token currentToken_;
+    bool refillPending_{false};
     Position statementPosition_;
+
+    ParserOptions options_;
+    std::size_t depth_{0};
+
+    // Nodes being built are allocated here. Handed over to the returned Program. Starts
+    // small for a single statement, a whole program quickly grows out of it
+    std::unique_ptr<Arena> arena_{std::make_unique<Arena>(minFragmentBlockSize)};
 };
 
 #include "parser.tpp"
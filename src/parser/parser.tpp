@@ -5,7 +5,7 @@
 
 template <typename Exception>
 void Parser::expect(Token::Type expected, const Exception& exception) {
-    if (currentToken_.getType() != expected)
+    if (currentToken().getType() != expected)
         throw exception;
 
     consumeToken();
@@ -13,15 +13,18 @@ void Parser::expect(Token::Type expected, const Exception& exception) {
 
 template <typename T, typename Exception>
 T Parser::expectAndReturnValue(Token::Type expected, const Exception& exception) {
-    const auto value = currentToken_.getValue();
-    expect(expected, exception);
-    return std::get<T>(value);
+    if (currentToken().getType() != expected)
+        throw exception;
+
+    T value = std::get<T>(currentToken().getValue());
+    consumeToken();
+    return value;
 }
 
 /// LIST = [ ELEM { ',' ELEM } ]
 template <typename T, typename ElementParser>
-std::vector<T> Parser::parseList(ElementParser elementParser) {
-    std::vector<T> elements;
+std::pmr::vector<T> Parser::parseList(ElementParser elementParser) {
+    std::pmr::vector<T> elements(arena_->getResource());
 
     auto element = std::invoke(elementParser, this);
     if (!element)
@@ -29,11 +32,11 @@ std::vector<T> Parser::parseList(ElementParser elementParser) {
 
     elements.push_back(std::move(*element));
 
-    while (currentToken_.getType() == Token::Type::CMA) {
+    while (currentToken().getType() == Token::Type::CMA) {
         consumeToken();
         element = std::invoke(elementParser, this);
         if (!element)
-            throw SyntaxException(currentToken_.getPosition(),
+            throw SyntaxException(currentToken().getPosition(),
                                   "Expected element after comma");
         elements.push_back(std::move(*element));
     }
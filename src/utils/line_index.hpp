@@ -0,0 +1,48 @@
+#ifndef LINE_INDEX_H
+#define LINE_INDEX_H
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "position.hpp"
+
+/// @brief Table of offsets at which the lines of a text file start
+///
+/// Built once while the file is read and used to convert positions into lines and
+/// columns
+class LineIndex {
+   public:
+    /// @brief Records the start of a line after every new line character in the block
+    /// @param block subsequent characters of the file
+    /// @param blockOffset offset of the first character of the block
+    void addBlock(std::string_view block, std::uint32_t blockOffset) {
+        const char* begin = block.data();
+        const char* end = begin + block.size();
+
+        while (auto newLine = static_cast<const char*>(
+                   std::memchr(begin, '\n', static_cast<std::size_t>(end - begin)))) {
+            const auto lineStart = blockOffset + (newLine - block.data()) + 1;
+            lineStarts_.push_back(static_cast<std::uint32_t>(lineStart));
+            begin = newLine + 1;
+        }
+    }
+
+    /// @brief Converts position into line and column, both counted from one
+    /// @param position of the character in the file
+    /// @return Line and column of the character or zeros if the position is unknown
+    LineColumn getLineColumn(Position position) const {
+        if (position.offset == Position::unknownOffset)
+            return {};
+
+        const auto next = std::ranges::upper_bound(lineStarts_, position.offset);
+        const auto line = static_cast<unsigned int>(next - lineStarts_.begin());
+        return {.line = line, .column = position.offset - *(next - 1) + 1};
+    }
+
+   private:
+    std::vector<std::uint32_t> lineStarts_{0};
+};
+
+#endif
@@ -1,8 +1,25 @@
 #ifndef POSITION_H
 #define POSITION_H
 
-/// @brief Position in text file
+#include <cstdint>
+#include <limits>
+
+/// @brief Position in text file stored as the offset of a character from the beginning
+/// of the file
+///
+/// Converted into line and column by LineIndex only when shown to the user
 struct Position {
+    static constexpr std::uint32_t unknownOffset{
+        std::numeric_limits<std::uint32_t>::max()};
+    /// @brief Greatest offset of a character or the end of a source. Longer sources are
+    /// rejected, so their offsets never wrap around or reach unknownOffset
+    static constexpr std::uint32_t maxOffset{unknownOffset - 1};
+
+    std::uint32_t offset{unknownOffset};
+};
+
+/// @brief Line and column of a character in text file
+struct LineColumn {
     unsigned int line{0};
     unsigned int column{0};
 };
@@ -0,0 +1,75 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <stop_token>
+
+/// @brief Lock-free bounded queue passing values from one producer thread to one
+/// consumer thread
+///
+/// Both sides block (spinning briefly, then sleeping) when the ring is full or empty
+template <typename T, std::size_t Capacity>
+class SpscRing {
+    static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+
+   public:
+    /// @brief Appends the value, waiting for free space. Producer only
+    /// @param value
+    /// @param stopToken stops waiting for free space when requested
+    /// @return False if stop was requested before the value could be appended
+    bool push(T value, std::stop_token stopToken) {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        auto head = head_.load(std::memory_order_acquire);
+
+        while (tail - head == Capacity) {
+            if (stopToken.stop_requested())
+                return false;
+            head_.wait(head, std::memory_order_acquire);
+            head = head_.load(std::memory_order_acquire);
+        }
+
+        slots_[tail % Capacity] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        tail_.notify_one();
+        return true;
+    }
+
+    /// @brief Removes the oldest value, waiting for one to be pushed. Consumer only
+    /// @return Removed value
+    T pop() {
+        const auto head = head_.load(std::memory_order_relaxed);
+        auto tail = tail_.load(std::memory_order_acquire);
+
+        while (tail == head) {
+            tail_.wait(tail, std::memory_order_acquire);
+            tail = tail_.load(std::memory_order_acquire);
+        }
+
+        T value = std::move(slots_[head % Capacity]);
+        head_.store(head + 1, std::memory_order_release);
+        head_.notify_one();
+        return value;
+    }
+
+    /// @brief Drops all values pushed so far, waking up the producer waiting for free
+    /// space. Consumer only
+    void clear() {
+        head_.store(tail_.load(std::memory_order_acquire), std::memory_order_release);
+        head_.notify_one();
+    }
+
+   private:
+    std::array<T, Capacity> slots_;
+
+    // Kept on separate cache lines, so both sides do not invalidate each other's cache
+    // on every operation
+    static constexpr std::size_t cacheLineSize{64};
+
+    alignas(cacheLineSize) std::atomic<std::size_t> head_{0};
+    alignas(cacheLineSize) std::atomic<std::size_t> tail_{0};
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef SYMBOL_H
+#define SYMBOL_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using SymbolId = std::uint32_t;
+
+/// @brief Global table of interned identifiers
+///
+/// Every distinct name is stored once and given a consecutive id. Safe to use from many
+/// threads, e.g. lexers running in parallel
+class SymbolTable {
+   public:
+    static SymbolTable& get() {
+        static SymbolTable table;
+        return table;
+    }
+
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    /// @brief Returns the id of the name, adding the name to the table if it is new
+    /// @param name
+    /// @return Id of the name
+    SymbolId intern(std::string_view name) {
+        {
+            const std::shared_lock lock(mutex_);
+            if (const auto it = ids_.find(name); it != ids_.end())
+                return it->second;
+        }
+
+        const std::unique_lock lock(mutex_);
+        // Another thread may have added the name in the meantime
+        if (const auto it = ids_.find(name); it != ids_.end())
+            return it->second;
+
+        const auto id = static_cast<SymbolId>(names_.size());
+        ids_.emplace(names_.emplace_back(name), id);
+        return id;
+    }
+
+    /// @brief Returns the name with the given id. Valid as long as the program runs
+    /// @param id returned by intern()
+    /// @return Name
+    std::string_view getName(SymbolId id) const {
+        const std::shared_lock lock(mutex_);
+        return names_[id];
+    }
+
+    /// @brief Returns the number of names in the table
+    std::size_t size() const {
+        const std::shared_lock lock(mutex_);
+        return names_.size();
+    }
+
+   private:
+    SymbolTable() { intern(""); }
+
+    mutable std::shared_mutex mutex_;
+    // Deque never moves the stored names, so views of them stay valid
+    std::deque<std::string> names_;
+    std::unordered_map<std::string_view, SymbolId> ids_;
+};
+
+/// @brief Identifier interned in the global SymbolTable. Symbols are compared by their
+/// ids, not names
+class Symbol {
+   public:
+    /// @brief Constructs a symbol with an empty name
+    Symbol() = default;
+
+    explicit Symbol(std::string_view name)
+        : id_(SymbolTable::get().intern(name)) {}
+
+    /// @brief Returns the symbol with the given id
+    /// @param id returned by getId() of an existing symbol
+    static Symbol fromId(SymbolId id) {
+        Symbol symbol;
+        symbol.id_ = id;
+        return symbol;
+    }
+
+    SymbolId getId() const { return id_; }
+    std::string_view getName() const { return SymbolTable::get().getName(id_); }
+
+    bool operator==(const Symbol&) const = default;
+    bool operator==(std::string_view name) const { return getName() == name; }
+
+   private:
+    SymbolId id_{0};
+};
+
+inline std::ostream& operator<<(std::ostream& os, const Symbol& symbol) {
+    return os << symbol.getName();
+}
+
+template <>
+struct std::hash<Symbol> {
+    std::size_t operator()(const Symbol& symbol) const noexcept {
+        return std::hash<SymbolId>()(symbol.getId());
+    }
+};
+
+#endif
@@ -4,6 +4,8 @@
 #include <string>
 #include <variant>
 
+#include "symbol.hpp"
+
 using Integral = int;
 using Floating = float;
 
@@ -16,7 +18,7 @@ enum class BuiltInType {
 
 struct VoidType {};
 
-using Type = std::variant<std::string, BuiltInType>;
-using ReturnType = std::variant<std::string, BuiltInType, VoidType>;
+using Type = std::variant<Symbol, BuiltInType>;
+using ReturnType = std::variant<Symbol, BuiltInType, VoidType>;
 
 #endif
@@ -26,14 +26,16 @@ class AcceptanceTest : public testing::Test {
     }
 
     template <typename Exception>
-    void interpretAndExpectThrowAt(Position position) {
+    void interpretAndExpectThrowAt(LineColumn position) {
         EXPECT_THROW(
             {
                 try {
                     interpreter_.interpret(program_);
                 } catch (const Exception& e) {
-                    EXPECT_EQ(e.getPosition().line, position.line);
-                    EXPECT_EQ(e.getPosition().column, position.column);
+                    const auto& lineIndex = source_->getLineIndex();
+                    const auto lineColumn = lineIndex.getLineColumn(e.getPosition());
+                    EXPECT_EQ(lineColumn.line, position.line);
+                    EXPECT_EQ(lineColumn.column, position.column);
                     throw;
                 }
             },
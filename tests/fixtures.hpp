@@ -35,6 +35,23 @@ class FakeLexer : public ILexer {
         return Token(default_, {}, {});
     }
 
+    /// @brief Writes tokens of subsequent types from the sequence into the buffer, up to
+    /// and including the end-of-text token
+    /// @return Number of tokens written
+    std::size_t getTokens(std::span<Token> tokens) {
+        std::size_t count{0};
+
+        while (count < tokens.size()) {
+            tokens[count] = getToken();
+            if (tokens[count++].getType() == default_)
+                break;
+        }
+        return count;
+    }
+
+    /// @brief Returns name of the identifier, the only text tokens of the sequence have
+    std::string getText(const Token& token) const { return std::string(token.getText()); }
+
    private:
     TypeSequence tokenSequence_;
     TypeSequence::iterator current_;
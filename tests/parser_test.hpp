@@ -6,22 +6,24 @@
 
 class ParserTest : public testing::Test {
    protected:
-    void Init(std::string input) {
+    void Init(std::string input, ParserOptions options = {}) {
         stream_ = std::istringstream(input);
         source_ = std::make_unique<Source>(stream_);
         lexer_ = std::make_unique<Lexer>(*source_);
-        parser_ = std::make_unique<Parser>(*lexer_);
+        parser_ = std::make_unique<Parser>(*lexer_, options);
     }
 
     template <typename Exception>
-    void parseAndExpectThrowAt(Position position) {
+    void parseAndExpectThrowAt(LineColumn position) {
         EXPECT_THROW(
             {
                 try {
                     parser_->parseProgram();
                 } catch (const Exception& e) {
-                    EXPECT_EQ(e.getPosition().line, position.line);
-                    EXPECT_EQ(e.getPosition().column, position.column);
+                    const auto& lineIndex = source_->getLineIndex();
+                    const auto lineColumn = lineIndex.getLineColumn(e.getPosition());
+                    EXPECT_EQ(lineColumn.line, position.line);
+                    EXPECT_EQ(lineColumn.column, position.column);
                     throw;
                 }
             },
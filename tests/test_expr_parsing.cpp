@@ -320,8 +320,8 @@ TEST_F(FullyParsedTest, parse_type_conversion_to_id_type) {
     EXPECT_EQ(std::get<Integral>(constant->value), 4);
 
     const auto& type = expression->type;
-    ASSERT_TRUE(std::holds_alternative<std::string>(type));
-    EXPECT_EQ(std::get<std::string>(type), "MyStruct");
+    ASSERT_TRUE(std::holds_alternative<Symbol>(type));
+    EXPECT_EQ(std::get<Symbol>(type), "MyStruct");
 }
 
 TEST_F(FullyParsedTest, parse_type_check_expression) {
@@ -496,3 +496,36 @@ TEST_F(FullyParsedTest, parse_struct_init_expr) {
     ASSERT_TRUE(std::holds_alternative<bool>(secondConstant->value));
     EXPECT_FALSE(std::get<bool>(secondConstant->value));
 }
+
+TEST_F(FullyParsedTest, parse_mixed_precedence_expression) {
+    Init("bool var = a + b * c < d or -e == f;");
+
+    const auto prog = parser_->parseProgram();
+
+    ASSERT_EQ(prog.statements.size(), 1);
+    const auto varDef = dynamic_cast<VarDef*>(prog.statements.at(0).get());
+    ASSERT_TRUE(varDef);
+    const auto disjunction =
+        dynamic_cast<DisjunctionExpression*>(varDef->expression.get());
+    ASSERT_TRUE(disjunction);
+    EXPECT_EQ(disjunction->position.offset, 11);
+
+    const auto lessThan = dynamic_cast<LessThanExpression*>(disjunction->lhs.get());
+    ASSERT_TRUE(lessThan);
+    const auto addition = dynamic_cast<AdditionExpression*>(lessThan->lhs.get());
+    ASSERT_TRUE(addition);
+    const auto multiplication =
+        dynamic_cast<MultiplicationExpression*>(addition->rhs.get());
+    ASSERT_TRUE(multiplication);
+    EXPECT_EQ(multiplication->position.offset, 15);
+
+    const auto equal = dynamic_cast<EqualExpression*>(disjunction->rhs.get());
+    ASSERT_TRUE(equal);
+    EXPECT_EQ(equal->position.offset, 28);
+    ASSERT_TRUE(dynamic_cast<SignChangeExpression*>(equal->lhs.get()));
+}
+
+TEST_F(ParserTest, parse_invalid_adjacent_relation_expressions) {
+    Init("bool var = a and b < c < d;");
+    parseAndExpectThrowAt<SyntaxException>({1, 24});
+}
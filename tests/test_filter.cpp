@@ -17,3 +17,38 @@ TEST(FilterTest, forbid_etx_filtering) {
     auto lexer = FakeLexer({Token::Type::ETX});
     EXPECT_THROW(Filter(lexer, Token::Type::ETX), InvalidFilterType);
 }
+
+TEST(FilterTest, getTokens_filtering) {
+    auto lexer = FakeLexer({Token::Type::CMT, Token::Type::SEMI, Token::Type::CMT,
+                            Token::Type::CMT, Token::Type::DOT});
+    auto filter = Filter(lexer, Token::Type::CMT);
+
+    std::vector<Token> tokens(2);
+    ASSERT_EQ(filter.getTokens(tokens), 1);
+    EXPECT_EQ(tokens[0].getType(), Token::Type::SEMI);
+    ASSERT_EQ(filter.getTokens(tokens), 2);
+    EXPECT_EQ(tokens[0].getType(), Token::Type::DOT);
+    EXPECT_EQ(tokens[1].getType(), Token::Type::ETX);
+}
+
+TEST(BasicFilterTest, filtering_several_types) {
+    auto lexer = FakeLexer({Token::Type::CMT, Token::Type::SEMI, Token::Type::DOT,
+                            Token::Type::CMA, Token::Type::CMT});
+    auto filter = BasicFilter<FakeLexer, Token::Type::CMT, Token::Type::DOT>(lexer);
+
+    EXPECT_EQ(filter.getToken().getType(), Token::Type::SEMI);
+    EXPECT_EQ(filter.getToken().getType(), Token::Type::CMA);
+    EXPECT_EQ(filter.getToken().getType(), Token::Type::ETX);
+}
+
+TEST(BasicFilterTest, getTokens_filtering_several_types) {
+    auto lexer = FakeLexer({Token::Type::CMT, Token::Type::DOT, Token::Type::CMT,
+                            Token::Type::SEMI, Token::Type::DOT});
+    auto filter = BasicFilter<FakeLexer, Token::Type::CMT, Token::Type::DOT>(lexer);
+
+    // The first batch is ignored entirely
+    std::vector<Token> tokens(3);
+    ASSERT_EQ(filter.getTokens(tokens), 2);
+    EXPECT_EQ(tokens[0].getType(), Token::Type::SEMI);
+    EXPECT_EQ(tokens[1].getType(), Token::Type::ETX);
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "flat_ast.hpp"
+#include "parser_test.hpp"
+
+TEST_F(FullyParsedTest, flatten_empty_program) {
+    Init("");
+
+    const auto ast = flatten(parser_->parseProgram());
+    EXPECT_TRUE(ast.getStatements().empty());
+    EXPECT_EQ(ast.getNodeCount(), 0);
+}
+
+TEST_F(FullyParsedTest, flatten_nodes_in_pre_order) {
+    Init(
+        "while a < 1.5 {"
+        "    int b = 2 + c;"
+        "}");
+
+    const auto ast = flatten(parser_->parseProgram());
+    ASSERT_EQ(ast.getStatements().size(), 1);
+    const auto loop = ast.getStatements()[0];
+    EXPECT_EQ(ast.getKind(loop), NodeKind::WHILE);
+    EXPECT_EQ(ast.getPosition(loop).offset, 0);
+
+    const auto condition = ast.getOperands(loop).first;
+    EXPECT_EQ(condition, loop + 1);
+    EXPECT_EQ(ast.getKind(condition), NodeKind::LESS_THAN);
+    const auto [lhs, rhs] = ast.getOperands(condition);
+    EXPECT_EQ(ast.getKind(lhs), NodeKind::VARIABLE_ACCESS);
+    EXPECT_EQ(FlatAst::getSymbol(ast.getOperands(lhs).first), "a");
+    EXPECT_EQ(std::get<Floating>(ast.getConstant(rhs)), 1.5f);
+
+    const auto body = ast.getList(ast.getOperands(loop).second);
+    ASSERT_EQ(body.size(), 1);
+    EXPECT_EQ(ast.getKind(body[0]), NodeKind::VAR_DEF);
+    const auto& variable = ast.getVariable(body[0]);
+    EXPECT_EQ(std::get<BuiltInType>(variable.type), BuiltInType::INT);
+    EXPECT_EQ(variable.name, "b");
+
+    const auto value = ast.getOperands(body[0]).second;
+    EXPECT_EQ(ast.getKind(value), NodeKind::ADDITION);
+    EXPECT_EQ(std::get<Integral>(ast.getConstant(ast.getOperands(value).first)), 2);
+    EXPECT_EQ(ast.getNodeCount(), 8);
+}
+
+TEST_F(FullyParsedTest, flatten_definitions_and_calls) {
+    Init(
+        "struct S { int x, str y }"
+        "void f(ref S s) { s.x = 1; }"
+        "f(ref v, {3, \"t\"});");
+
+    const auto ast = flatten(parser_->parseProgram());
+    const auto statements = ast.getStatements();
+    ASSERT_EQ(statements.size(), 3);
+
+    const auto fields = ast.getFields(statements[0]);
+    ASSERT_EQ(fields.size(), 2);
+    EXPECT_EQ(fields[1].name, "y");
+
+    const auto function = ast.getFunction(statements[1]);
+    EXPECT_EQ(function.name, "f");
+    ASSERT_EQ(function.parameters.size(), 1);
+    EXPECT_TRUE(function.parameters[0].ref);
+    const auto body = ast.getList(ast.getOperands(statements[1]).second);
+    ASSERT_EQ(body.size(), 1);
+    const auto lhs = ast.getOperands(body[0]).first;
+    EXPECT_EQ(ast.getKind(lhs), NodeKind::FIELD_ACCESS);
+    EXPECT_EQ(FlatAst::getSymbol(ast.getOperands(lhs).second), "x");
+
+    EXPECT_EQ(ast.getKind(statements[2]), NodeKind::FUNC_CALL);
+    const auto args = ast.getList(ast.getOperands(statements[2]).second);
+    ASSERT_EQ(args.size(), 2);
+    EXPECT_EQ(ast.getKind(args[0]), NodeKind::REF_ARGUMENT);
+    EXPECT_EQ(ast.getKind(args[1]), NodeKind::ARGUMENT);
+    const auto init = ast.getOperands(args[1]).first;
+    const auto values = ast.getList(ast.getOperands(init).first);
+    ASSERT_EQ(values.size(), 2);
+    EXPECT_EQ(std::get<std::string>(ast.getConstant(values[1])), "t");
+}
+
+TEST_F(FullyParsedTest, flatten_str_constant_not_interned) {
+    Init("print \"never interned\";");
+    const auto program = parser_->parseProgram();
+
+    const auto symbolCount = SymbolTable::get().size();
+    const auto ast = flatten(program);
+
+    EXPECT_EQ(SymbolTable::get().size(), symbolCount);
+    const auto print = ast.getStatements()[0];
+    const auto constant = ast.getOperands(print).first;
+    EXPECT_EQ(std::get<std::string>(ast.getConstant(constant)), "never interned");
+}
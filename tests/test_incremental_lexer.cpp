@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include "incremental_lexer.hpp"
+#include "lexer_errors.hpp"
+
+std::vector<Token> lexAll(std::string_view text) {
+    auto source = Source(text);
+    auto lexer = Lexer(source);
+
+    std::vector<Token> tokens;
+    do {
+        tokens.push_back(lexer.getToken());
+    } while (tokens.back().getType() != Token::Type::ETX);
+    return tokens;
+}
+
+/// @brief Compares the tokens, including text of the tokens found in the text
+void expectSameTokens(const std::vector<Token>& actual,
+                      const std::vector<Token>& expected, std::string_view text) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t i{0}; i < actual.size(); ++i) {
+        EXPECT_EQ(actual[i].getType(), expected[i].getType()) << "Token " << i;
+        EXPECT_EQ(actual[i].getValue(), expected[i].getValue()) << "Token " << i;
+        EXPECT_EQ(Lexer::getText(actual[i], text), Lexer::getText(expected[i], text))
+            << "Token " << i;
+        EXPECT_EQ(actual[i].getPosition().offset, expected[i].getPosition().offset)
+            << "Token " << i;
+    }
+}
+
+/// @brief Applies the edit to the text and relexes the tokens of the original text
+TokenRange applyEdit(std::string& text, const Edit& edit, std::vector<Token>& tokens) {
+    text.replace(edit.offset, edit.removedLength, edit.insertedText);
+    return relex(text, edit, tokens);
+}
+
+struct RelexCase {
+    std::string text;
+    Edit edit;
+};
+
+class RelexTest : public testing::TestWithParam<RelexCase> {};
+
+TEST_P(RelexTest, relex_same_as_lexing_from_scratch) {
+    auto text = GetParam().text;
+    auto tokens = lexAll(text);
+
+    applyEdit(text, GetParam().edit, tokens);
+
+    expectSameTokens(tokens, lexAll(text), text);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Edits, RelexTest,
+    testing::Values(
+        RelexCase{"int a = 1;\nint b = 2;\n", {.offset = 5, .insertedText = "bc"}},
+        RelexCase{"int a = 1;\nint b = 2;\n", {.offset = 0, .insertedText = "# "}},
+        RelexCase{"int a = 1;\nint b = 2;\n",
+                  {.offset = 9, .removedLength = 2, .insertedText = ""}},
+        RelexCase{"int a = 1;\nint b = 2;\n", {.offset = 20, .insertedText = "x;"}},
+        RelexCase{"a < b;", {.offset = 3, .insertedText = "="}},
+        RelexCase{"a = 1; b = 2;\nc = 3;", {.offset = 7, .insertedText = "#"}},
+        RelexCase{"# comment\nprint 1;",
+                  {.offset = 9, .removedLength = 1, .insertedText = ""}},
+        RelexCase{"print \"a b\";",
+                  {.offset = 6, .removedLength = 5, .insertedText = "x"}},
+        RelexCase{"  a;", {.offset = 0, .removedLength = 2, .insertedText = ""}}));
+
+TEST(RelexTest, relex_only_changed_tokens) {
+    std::string text;
+    for (int i{0}; i < 100; ++i)
+        text += "int a = 1;\n";
+    auto tokens = lexAll(text);
+    const auto tokenCount = tokens.size();
+
+    // "int a = 1;" becomes "int abc = 1;" in the 51st line
+    const auto range =
+        applyEdit(text, {.offset = 50 * 11 + 5, .insertedText = "bc"}, tokens);
+
+    EXPECT_EQ(range.begin, 50 * 5 + 1);
+    EXPECT_EQ(range.removed, 1);
+    EXPECT_EQ(range.inserted, 1);
+    EXPECT_EQ(tokens.size(), tokenCount);
+    EXPECT_EQ(tokens[range.begin].getText(), "abc");
+    expectSameTokens(tokens, lexAll(text), text);
+}
+
+TEST(RelexTest, relex_shifts_tokens_after_changed_count) {
+    std::string text;
+    for (int i{0}; i < 100; ++i)
+        text += "print \"a\";\n";
+    auto tokens = lexAll(text);
+    const auto tokenCount = tokens.size();
+
+    // "b = 2; " at the start of the 51st line adds 4 tokens and 7 characters
+    const auto range =
+        applyEdit(text, {.offset = 50 * 11, .insertedText = "b = 2; "}, tokens);
+
+    EXPECT_EQ(range.inserted - range.removed, 4);
+    ASSERT_EQ(tokens.size(), tokenCount + 4);
+
+    const auto& print = tokens[51 * 3 + 4];
+    EXPECT_EQ(print.getType(), Token::Type::PRINT_KW);
+    EXPECT_EQ(print.getPosition().offset, 51 * 11 + 7);
+
+    const auto& strConst = tokens[51 * 3 + 5];
+    EXPECT_EQ(strConst.getPosition().offset, 51 * 11 + 7 + 6);
+    EXPECT_EQ(Lexer::getText(strConst, text), "a");
+
+    expectSameTokens(tokens, lexAll(text), text);
+}
+
+TEST(RelexTest, relex_error_leaves_tokens_unchanged) {
+    std::string text{"a = 1;"};
+    auto tokens = lexAll(text);
+    const auto previous = tokens;
+
+    EXPECT_THROW(applyEdit(text, {.offset = 4, .insertedText = "&"}, tokens),
+                 InvalidToken);
+    expectSameTokens(tokens, previous, text);
+}
@@ -25,14 +25,16 @@ class InterpreterTest : public testing::Test {
     }
 
     template <typename Exception>
-    void interpretAndExpectThrowAt(Position position) {
+    void interpretAndExpectThrowAt(LineColumn position) {
         EXPECT_THROW(
             {
                 try {
                     interpreter_.interpret(program_);
                 } catch (const Exception& e) {
-                    EXPECT_EQ(e.getPosition().line, position.line);
-                    EXPECT_EQ(e.getPosition().column, position.column);
+                    const auto& lineIndex = source_->getLineIndex();
+                    const auto lineColumn = lineIndex.getLineColumn(e.getPosition());
+                    EXPECT_EQ(lineColumn.line, position.line);
+                    EXPECT_EQ(lineColumn.column, position.column);
                     throw;
                 }
             },
@@ -347,7 +349,7 @@ TEST_F(InterpreterTest, struct_definition) {
         "    Point y"
         "}");
     interpretAndGetOutput();
-    const StructDef* structDef = interpreter_.getStructDef("Point");
+    const StructDef* structDef = interpreter_.getStructDef(Symbol("Point"));
 
     EXPECT_EQ(structDef->name, "Point");
     ASSERT_EQ(structDef->fields.size(), 2);
@@ -359,8 +361,8 @@ TEST_F(InterpreterTest, struct_definition) {
 
     const auto secondField = structDef->fields.at(1);
     EXPECT_EQ(secondField.name, "y");
-    ASSERT_TRUE(std::holds_alternative<std::string>(secondField.type));
-    EXPECT_EQ(std::get<std::string>(secondField.type), "Point");
+    ASSERT_TRUE(std::holds_alternative<Symbol>(secondField.type));
+    EXPECT_EQ(std::get<Symbol>(secondField.type), "Point");
 }
 
 TEST_F(InterpreterTest, struct_var_def) {
@@ -372,7 +374,7 @@ TEST_F(InterpreterTest, struct_var_def) {
         "Point p = {1, 2.0};");
     interpretAndGetOutput();
 
-    const auto varRef = interpreter_.getVariable("p");
+    const auto varRef = interpreter_.getVariable(Symbol("p"));
     ASSERT_TRUE(varRef);
     const auto valueObj = varRef->valueObj;
     ASSERT_TRUE(std::holds_alternative<NamedStructObj>(valueObj->value));
@@ -410,7 +412,7 @@ TEST_F(InterpreterTest, struct_assignment) {
         "p = {4, 5.0};");
     interpretAndGetOutput();
 
-    const auto varRef = interpreter_.getVariable("p");
+    const auto varRef = interpreter_.getVariable(Symbol("p"));
     ASSERT_TRUE(varRef);
     const auto valueObj = varRef->valueObj;
 
@@ -573,7 +575,7 @@ TEST_F(InterpreterTest, nested_struct_initialization) {
         "B b = {{5}};");
     interpretAndGetOutput();
 
-    const auto varRefB = interpreter_.getVariable("b");
+    const auto varRefB = interpreter_.getVariable(Symbol("b"));
     ASSERT_TRUE(varRefB);
     const auto valueRefB = varRefB->valueObj;
 
@@ -600,7 +602,7 @@ TEST_F(InterpreterTest, nested_struct_assignment) {
         "b = {{7}};");
     interpretAndGetOutput();
 
-    const auto varRefB = interpreter_.getVariable("b");
+    const auto varRefB = interpreter_.getVariable(Symbol("b"));
     ASSERT_TRUE(varRefB);
     const auto valueObjB = varRefB->valueObj;
 
@@ -660,7 +662,7 @@ TEST_F(InterpreterTest, variant_definition) {
     Init("variant IntOrBool { int, bool }");
     interpretAndGetOutput();
 
-    const VariantDef* variantDef = interpreter_.getVariantDef("IntOrBool");
+    const VariantDef* variantDef = interpreter_.getVariantDef(Symbol("IntOrBool"));
     ASSERT_TRUE(variantDef);
     EXPECT_EQ(variantDef->name, "IntOrBool");
     EXPECT_EQ(variantDef->types.size(), 2);
@@ -680,7 +682,7 @@ TEST_F(InterpreterTest, variant_var_def) {
         "IntOrBool i = 5;");
     interpretAndGetOutput();
 
-    const auto varRef = interpreter_.getVariable("i");
+    const auto varRef = interpreter_.getVariable(Symbol("i"));
     ASSERT_TRUE(varRef);
     ASSERT_TRUE(std::holds_alternative<VariantObj>(varRef->valueObj->value));
     const auto& variantObj = std::get<VariantObj>(varRef->valueObj->value);
@@ -1188,3 +1190,63 @@ TEST_F(InterpreterTest, max_recursion_depth) {
         "foo();");
     interpretAndExpectThrowAt<MaxRecursionDepth>({1, 14});
 }
+
+TEST_F(InterpreterTest, interpret_statements_while_parsing) {
+    const std::string input{
+        "struct Point { int x, int y }"
+        "print 1;"
+        "if true { int helper() { return 2; } print helper(); }"
+        "int sum(Point p) { return p.x + p.y; }"
+        "Point p = {1, 2};"
+        "print sum(p);"};
+    auto source = Source(std::string_view(input));
+    auto lexer = Lexer(source);
+    auto parser = Parser(lexer);
+
+    // Each statement is freed right after running unless it defines something
+    while (true) {
+        auto fragment = parser.parseNextStatement();
+        if (fragment.statements.empty())
+            break;
+        interpreter_.interpret(std::move(fragment));
+    }
+
+    EXPECT_EQ(output_.str(), "1\n2\n3\n");
+}
+
+/// @brief Stream buffer handing out one line per read, like a pipe written line by line
+class LineByLineBuf : public std::streambuf {
+   public:
+    explicit LineByLineBuf(std::vector<std::string> lines) : lines_(std::move(lines)) {}
+
+    std::size_t getReadCount() const { return readCount_; }
+
+   protected:
+    int_type underflow() override {
+        if (readCount_ == lines_.size())
+            return traits_type::eof();
+        auto& line = lines_[readCount_++];
+        setg(line.data(), line.data(), line.data() + line.size());
+        return traits_type::to_int_type(line.front());
+    }
+
+   private:
+    std::vector<std::string> lines_;
+    std::size_t readCount_{0};
+};
+
+TEST_F(InterpreterTest, interpret_streamed_statement_before_next_arrives) {
+    LineByLineBuf buf({"int a = 1;\n", "print a;\n", "print a + 1;\n"});
+    std::istream stream(&buf);
+    auto source = Source(stream, Source::defaultBlockSize, true);
+    auto lexer = Lexer(source);
+    auto parser = Parser(lexer);
+
+    for (std::size_t line = 1; line <= 3; ++line) {
+        interpreter_.interpret(parser.parseNextStatement());
+        EXPECT_EQ(buf.getReadCount(), line);
+    }
+
+    EXPECT_TRUE(parser.parseNextStatement().statements.empty());
+    EXPECT_EQ(output_.str(), "1\n2\n");
+}
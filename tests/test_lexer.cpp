@@ -1,17 +1,20 @@
 #include <gtest/gtest.h>
 
+#include "keywords.hpp"
 #include "lexer.hpp"
 #include "lexer_errors.hpp"
+#include "magic_enum/magic_enum.hpp"
 #include "types.hpp"
 
 using TypeSequence = std::vector<Token::Type>;
 
 class LexerTest : public testing::Test {
    protected:
-    void Init(const std::string& input) {
+    void Init(const std::string& input,
+              Lexer::CommentMode commentMode = Lexer::CommentMode::KEEP) {
         stream_ = std::istringstream(input);
         source_ = std::make_unique<Source>(stream_);
-        lexer_ = std::make_unique<Lexer>(*source_);
+        lexer_ = std::make_unique<Lexer>(*source_, commentMode);
     }
 
     std::istringstream stream_;
@@ -53,13 +56,49 @@ TEST_F(LexerTest, getToken_while_keyword) {
     EXPECT_EQ(lexer_->getToken().getType(), Token::Type::ETX) << "Invalid type";
 }
 
+/// @brief Checks that the keyword is the lowercase name of its token type without the
+/// _KW suffix
+constexpr bool matchesTypeName(const Keyword& keyword) {
+    auto name = magic_enum::enum_name(keyword.type);
+    if (!name.ends_with("_KW"))
+        return false;
+    name.remove_suffix(3);
+    return std::ranges::equal(keyword.lexeme, name, {},
+                              [](char c) { return static_cast<char>(c - 'a' + 'A'); });
+}
+
+constexpr bool keywordTableCoversKeywordTypes() {
+    const auto keywordTypes = std::ranges::count_if(
+        magic_enum::enum_values<Token::Type>(),
+        [](Token::Type type) { return magic_enum::enum_name(type).ends_with("_KW"); });
+
+    return keywordTypes == keywords.size()
+           && std::ranges::all_of(keywords, [](const Keyword& keyword) {
+                  return matchesTypeName(keyword)
+                         && findKeyword(keyword.lexeme) == keyword.type;
+              });
+}
+
+TEST(KeywordTableTest, covers_exactly_keyword_types) {
+    static_assert(keywordTableCoversKeywordTypes());
+    static_assert(!findKeyword("While"));
+    static_assert(!findKeyword("whilst"));
+}
+
+TEST_F(LexerTest, getToken_all_keywords) {
+    for (const auto& keyword : keywords) {
+        Init(std::string(keyword.lexeme));
+        EXPECT_EQ(lexer_->getToken().getType(), keyword.type) << keyword.lexeme;
+    }
+}
+
 TEST_F(LexerTest, getToken_id) {
     Init("valid_identifier_123");
 
     auto token = lexer_->getToken();
 
     ASSERT_EQ(token.getType(), Token::Type::ID) << "Invalid type";
-    EXPECT_EQ(std::get<std::string>(token.getValue()), "valid_identifier_123")
+    EXPECT_EQ(std::get<Symbol>(token.getValue()), "valid_identifier_123")
         << "Invalid value";
 
     EXPECT_EQ(lexer_->getToken().getType(), Token::Type::ETX) << "Invalid type";
@@ -71,11 +110,22 @@ TEST_F(LexerTest, getToken_id_pretending_to_be_keyword) {
     auto token = lexer_->getToken();
 
     ASSERT_EQ(token.getType(), Token::Type::ID) << "Keywords are lowercase only";
-    EXPECT_EQ(std::get<std::string>(token.getValue()), "While") << "Invalid value";
+    EXPECT_EQ(std::get<Symbol>(token.getValue()), "While") << "Invalid value";
 
     EXPECT_EQ(lexer_->getToken().getType(), Token::Type::ETX) << "Invalid type";
 }
 
+TEST_F(LexerTest, getToken_same_ids_share_symbol) {
+    Init("abc xyz abc");
+
+    const auto first = std::get<Symbol>(lexer_->getToken().getValue());
+    const auto second = std::get<Symbol>(lexer_->getToken().getValue());
+    const auto third = std::get<Symbol>(lexer_->getToken().getValue());
+
+    EXPECT_EQ(first.getId(), third.getId());
+    EXPECT_NE(first.getId(), second.getId());
+}
+
 TEST_F(LexerTest, getToken_int) {
     Init("1234");
 
@@ -145,12 +195,69 @@ TEST_F(LexerTest, getToken_float_overflow) {
     EXPECT_THROW(lexer_->getToken(), NumericOverflow) << "Max exceeded";
 }
 
+TEST_F(LexerTest, getToken_float_integral_overflow) {
+    Init("99999999999999999999.5");
+
+    EXPECT_THROW(lexer_->getToken(), NumericOverflow) << "Max exceeded";
+}
+
+TEST_F(LexerTest, getToken_float_long_fractional_part) {
+    Init("0.0000000000125");
+
+    auto token = lexer_->getToken();
+
+    ASSERT_EQ(token.getType(), Token::Type::FLOAT_CONST) << "Invalid type";
+    EXPECT_EQ(std::get<float>(token.getValue()), 0.0000000000125f) << "Invalid value";
+}
+
 TEST_F(LexerTest, getToken_invalid) {
     Init("&324");
 
     EXPECT_THROW(lexer_->getToken(), InvalidToken);
 }
 
+TEST_F(LexerTest, getToken_non_ascii_id) {
+    Init("zażółć = \"gęślą jaźń 🐢\"");
+
+    auto token = lexer_->getToken();
+    ASSERT_EQ(token.getType(), Token::Type::ID) << "Invalid type";
+    EXPECT_EQ(token.getText(), "zażółć") << "Invalid value";
+
+    EXPECT_EQ(lexer_->getToken().getType(), Token::Type::ASGN_OP) << "Invalid type";
+    EXPECT_EQ(lexer_->getText(lexer_->getToken()), "gęślą jaźń 🐢") << "Invalid value";
+}
+
+TEST_F(LexerTest, getToken_non_ascii_across_blocks) {
+    // Every multibyte character is cut off by the end of some block
+    stream_ = std::istringstream("ażółć😀 ");
+    source_ = std::make_unique<Source>(stream_, 2);
+    lexer_ = std::make_unique<Lexer>(*source_);
+
+    EXPECT_EQ(lexer_->getToken().getText(), "ażółć😀");
+    EXPECT_EQ(lexer_->getToken().getType(), Token::Type::ETX);
+}
+
+TEST_F(LexerTest, getToken_invalid_utf8) {
+    Init("a = \"b\xe2\x82\"");
+
+    EXPECT_EQ(lexer_->getToken().getType(), Token::Type::ID);
+    EXPECT_EQ(lexer_->getToken().getType(), Token::Type::ASGN_OP);
+    try {
+        lexer_->getToken();
+        FAIL() << "Expected InvalidUtf8";
+    } catch (const InvalidUtf8& e) {
+        EXPECT_EQ(e.getPosition().offset, 6) << "Invalid position";
+    }
+}
+
+TEST(ZeroCopyLexerTest, getToken_invalid_utf8) {
+    auto source = Source(std::string_view("ab\xc3("));
+    auto lexer = Lexer(source);
+
+    EXPECT_EQ(lexer.getToken().getText(), "ab");
+    EXPECT_THROW(lexer.getToken(), InvalidUtf8);
+}
+
 TEST_F(LexerTest, getToken_empty_source) {
     Init("");
 
@@ -210,7 +317,7 @@ TEST_F(LexerTest, getToken_str_const_empty) {
 
     auto token = lexer_->getToken();
     ASSERT_EQ(token.getType(), Token::Type::STR_CONST) << "Invalid type";
-    EXPECT_EQ(std::get<std::string>(token.getValue()), "") << "Invalid token.getValue()";
+    EXPECT_EQ(lexer_->getText(token), "") << "Invalid token.getValue()";
 
     EXPECT_EQ(lexer_->getToken().getType(), Token::Type::ETX) << "Invalid type";
 }
@@ -220,8 +327,7 @@ TEST_F(LexerTest, getToken_str_const_new_line) {
 
     auto token = lexer_->getToken();
     ASSERT_EQ(token.getType(), Token::Type::STR_CONST) << "Invalid type";
-    EXPECT_EQ(std::get<std::string>(token.getValue()), "a\nb")
-        << "Invalid token.getValue()";
+    EXPECT_EQ(lexer_->getText(token), "a\nb") << "Invalid token.getValue()";
 
     EXPECT_EQ(lexer_->getToken().getType(), Token::Type::ETX) << "Invalid type";
 }
@@ -231,8 +337,7 @@ TEST_F(LexerTest, getToken_str_const_quotation_mark) {
 
     auto token = lexer_->getToken();
     ASSERT_EQ(token.getType(), Token::Type::STR_CONST) << "Invalid type";
-    EXPECT_EQ(std::get<std::string>(token.getValue()), R"(")")
-        << "Invalid token.getValue()";
+    EXPECT_EQ(lexer_->getText(token), R"(")") << "Invalid token.getValue()";
 
     EXPECT_EQ(lexer_->getToken().getType(), Token::Type::ETX) << "Invalid type";
 }
@@ -242,8 +347,7 @@ TEST_F(LexerTest, getToken_str_const_backslash) {
 
     auto token = lexer_->getToken();
     ASSERT_EQ(token.getType(), Token::Type::STR_CONST) << "Invalid type";
-    EXPECT_EQ(std::get<std::string>(token.getValue()), R"(\)")
-        << "Invalid token.getValue()";
+    EXPECT_EQ(lexer_->getText(token), R"(\)") << "Invalid token.getValue()";
 
     EXPECT_EQ(lexer_->getToken().getType(), Token::Type::ETX) << "Invalid type";
 }
@@ -253,12 +357,33 @@ TEST_F(LexerTest, getToken_str_const_complicated) {
 
     auto token = lexer_->getToken();
     ASSERT_EQ(token.getType(), Token::Type::STR_CONST) << "Invalid type";
-    EXPECT_EQ(std::get<std::string>(token.getValue()), "\"lama \nma \\ delfina\"")
+    EXPECT_EQ(lexer_->getText(token), "\"lama \nma \\ delfina\"")
         << "Invalid token.getValue()";
 
     EXPECT_EQ(lexer_->getToken().getType(), Token::Type::ETX) << "Invalid type";
 }
 
+TEST_F(LexerTest, getToken_str_const_long_with_escapes) {
+    const std::string text(40, 'a');
+    Init('"' + text + R"(\"\\)" + text + '"');
+
+    auto token = lexer_->getToken();
+    EXPECT_EQ(token.getType(), Token::Type::STR_CONST);
+    EXPECT_EQ(lexer_->getText(token), text + R"("\)" + text);
+}
+
+TEST_F(LexerTest, getText_of_str_const_from_dropped_block) {
+    stream_ = std::istringstream(R"("abc\tdef" "g")");
+    source_ = std::make_unique<Source>(stream_, 2);
+    lexer_ = std::make_unique<Lexer>(*source_);
+
+    // The lexer keeps the text once the source has moved on to next blocks
+    const auto first = lexer_->getToken();
+    const auto second = lexer_->getToken();
+    EXPECT_EQ(lexer_->getText(first), "abc\tdef");
+    EXPECT_EQ(lexer_->getText(second), "g");
+}
+
 TEST_F(LexerTest, getToken_not_terminated_str_const) {
     Init(R"("no ending quotation mark)");
 
@@ -284,7 +409,7 @@ TEST_F(LexerTest, getToken_comment) {
 
     auto token = lexer_->getToken();
     ASSERT_EQ(token.getType(), Token::Type::CMT) << "Invalid type";
-    EXPECT_EQ(std::get<std::string>(token.getValue()), R"( int 12 # "abc")");
+    EXPECT_EQ(lexer_->getText(token), R"( int 12 # "abc")");
 
     EXPECT_EQ(lexer_->getToken().getType(), Token::Type::ETX) << "Invalid type";
 }
@@ -294,31 +419,49 @@ TEST_F(LexerTest, getToken_end_comment_at_new_line) {
 
     auto token = lexer_->getToken();
     ASSERT_EQ(token.getType(), Token::Type::CMT) << "Invalid type";
-    EXPECT_EQ(std::get<std::string>(token.getValue()), R"( first line)");
+    EXPECT_EQ(lexer_->getText(token), R"( first line)");
+}
+
+TEST_F(LexerTest, getToken_discard_comments) {
+    Init("int # first\n  # second\n\n#third\n; #last", Lexer::CommentMode::DISCARD);
+
+    EXPECT_EQ(lexer_->getToken().getType(), Token::Type::INT_KW) << "Invalid type";
+
+    const auto token = lexer_->getToken();
+    EXPECT_EQ(token.getType(), Token::Type::SEMI) << "Invalid type";
+    EXPECT_EQ(token.getPosition().offset, 31) << "Invalid position";
+
+    EXPECT_EQ(lexer_->getToken().getType(), Token::Type::ETX) << "Invalid type";
 }
 
 TEST_F(LexerTest, getToken_token_position_one_line) {
     Init("int void");
 
     auto token = lexer_->getToken();
-    EXPECT_EQ(token.getPosition().line, 1);
-    EXPECT_EQ(token.getPosition().column, 1);
+    EXPECT_EQ(token.getPosition().offset, 0);
+    auto lineColumn = source_->getLineIndex().getLineColumn(token.getPosition());
+    EXPECT_EQ(lineColumn.line, 1);
+    EXPECT_EQ(lineColumn.column, 1);
 
     token = lexer_->getToken();
-    EXPECT_EQ(token.getPosition().line, 1);
-    EXPECT_EQ(token.getPosition().column, 5);
+    EXPECT_EQ(token.getPosition().offset, 4);
+    lineColumn = source_->getLineIndex().getLineColumn(token.getPosition());
+    EXPECT_EQ(lineColumn.line, 1);
+    EXPECT_EQ(lineColumn.column, 5);
 }
 
 TEST_F(LexerTest, getToken_token_position_two_lines) {
     Init("abc\ndef");
 
     auto token = lexer_->getToken();
-    EXPECT_EQ(token.getPosition().line, 1);
-    EXPECT_EQ(token.getPosition().column, 1);
+    auto lineColumn = source_->getLineIndex().getLineColumn(token.getPosition());
+    EXPECT_EQ(lineColumn.line, 1);
+    EXPECT_EQ(lineColumn.column, 1);
 
     token = lexer_->getToken();
-    EXPECT_EQ(token.getPosition().line, 2);
-    EXPECT_EQ(token.getPosition().column, 1);
+    lineColumn = source_->getLineIndex().getLineColumn(token.getPosition());
+    EXPECT_EQ(lineColumn.line, 2);
+    EXPECT_EQ(lineColumn.column, 1);
 }
 
 TEST_F(LexerTest, getToken_multiple_tokens) {
@@ -340,3 +483,61 @@ TEST_F(LexerTest, getToken_multiple_tokens) {
     for (auto type : seq)
         EXPECT_EQ(lexer_->getToken().getType(), type) << "Invalid type";
 }
+
+TEST(ZeroCopyLexerTest, getToken_interns_identifiers_only) {
+    const std::string_view text = R"(name "name" # name)";
+    auto source = Source(text);
+    auto lexer = Lexer(source);
+
+    // Str literals and comments only hold the length of their text following them
+    const auto id = std::get<Symbol>(lexer.getToken().getValue());
+    const auto strConst = lexer.getToken();
+    const auto comment = lexer.getToken();
+
+    EXPECT_EQ(id.getName(), "name");
+    EXPECT_EQ(strConst.getValue(), Token::Value());
+    EXPECT_EQ(strConst.getTextHandle(), 4);
+    EXPECT_EQ(lexer.getText(strConst), "name");
+    EXPECT_EQ(Lexer::getText(comment, text), " name");
+}
+
+TEST(ZeroCopyLexerTest, getToken_numbers) {
+    auto source = Source(std::string_view("012 3.25 4."));
+    auto lexer = Lexer(source);
+
+    EXPECT_EQ(std::get<int>(lexer.getToken().getValue()), 0);
+    EXPECT_EQ(std::get<int>(lexer.getToken().getValue()), 12);
+    EXPECT_EQ(std::get<float>(lexer.getToken().getValue()), 3.25f);
+    EXPECT_THROW(lexer.getToken(), InvalidFloat);
+}
+
+TEST(ZeroCopyLexerTest, getToken_str_const_with_escape) {
+    const std::string_view text = R"(a = "a\nb")";
+    auto source = Source(text);
+    auto lexer = Lexer(source);
+
+    lexer.getToken();
+    lexer.getToken();
+    const auto token = lexer.getToken();
+    EXPECT_EQ(lexer.getText(token), "a\nb");
+    EXPECT_EQ(Lexer::getText(token, text), "a\nb");
+}
+
+TEST_F(LexerTest, getTokens_stops_at_end_of_text) {
+    Init("a = 1;");
+
+    std::vector<Token> tokens(8);
+    ASSERT_EQ(lexer_->getTokens(tokens), 5);
+    EXPECT_EQ(tokens[0].getType(), Token::Type::ID);
+    EXPECT_EQ(tokens[3].getType(), Token::Type::SEMI);
+    EXPECT_EQ(tokens[4].getType(), Token::Type::ETX);
+}
+
+TEST_F(LexerTest, getTokens_defers_error) {
+    Init("a; $");
+
+    std::vector<Token> tokens(8);
+    ASSERT_EQ(lexer_->getTokens(tokens), 2);
+    EXPECT_EQ(tokens[1].getType(), Token::Type::SEMI);
+    EXPECT_THROW(lexer_->getTokens(tokens), InvalidToken);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "flat_ast.hpp"
+#include "parser_test.hpp"
+
+std::string nestedBlocks(std::size_t depth) {
+    std::string input;
+    for (std::size_t i = 0; i < depth; ++i)
+        input += "while a {";
+    return input + "print a;" + std::string(depth, '}');
+}
+
+std::string nestedParentheses(std::size_t depth) {
+    return "print " + std::string(depth, '(') + "1" + std::string(depth, ')') + ";";
+}
+
+TEST_F(FullyParsedTest, explicit_stack_parses_deeply_nested_parentheses) {
+    constexpr std::size_t depth{100000};
+    Init(nestedParentheses(depth), {.explicitStack = true, .maxDepth = 2 * depth});
+
+    const auto prog = parser_->parseProgram();
+    ASSERT_EQ(prog.statements.size(), 1);
+    const auto printStatement =
+        dynamic_cast<PrintStatement*>(prog.statements.at(0).get());
+    ASSERT_TRUE(printStatement);
+    ASSERT_TRUE(dynamic_cast<Constant*>(printStatement->expression.get()));
+}
+
+TEST_F(FullyParsedTest, explicit_stack_parses_deeply_nested_blocks) {
+    constexpr std::size_t depth{100000};
+    Init(nestedBlocks(depth), {.explicitStack = true, .maxDepth = depth + 2});
+
+    auto prog = parser_->parseProgram();
+
+    // Walked down in a loop, recursive walkers (e.g. flatten()) would overflow the stack
+    const Statements* statements = &prog.statements;
+    std::size_t whileCount{0};
+    while (statements->size() == 1) {
+        const auto whileStatement =
+            dynamic_cast<const WhileStatement*>(statements->front().get());
+        if (!whileStatement)
+            break;
+        ++whileCount;
+        statements = &whileStatement->statements;
+    }
+    EXPECT_EQ(whileCount, depth);
+    ASSERT_EQ(statements->size(), 1);
+    EXPECT_TRUE(dynamic_cast<const PrintStatement*>(statements->front().get()));
+
+    // Destroying the tree does not recurse either
+    prog = {};
+    EXPECT_TRUE(prog.statements.empty());
+}
+
+TEST_F(FullyParsedTest, explicit_stack_flattens_nested_blocks) {
+    constexpr std::size_t depth{1000};
+    Init(nestedBlocks(depth), {.explicitStack = true, .maxDepth = depth + 2});
+
+    const auto ast = flatten(parser_->parseProgram());
+    EXPECT_EQ(ast.getNodeCount(), 2 * depth + 2);
+}
+
+TEST_F(ParserTest, nesting_deeper_than_limit) {
+    constexpr std::size_t depth{ParserOptions::defaultMaxDepth};
+    for (const bool explicitStack : {false, true}) {
+        Init(nestedBlocks(depth), {.explicitStack = explicitStack});
+        parseAndExpectThrowAt<SyntaxException>({1, 9 * depth + 1});
+
+        Init(nestedParentheses(depth), {.explicitStack = explicitStack});
+        parseAndExpectThrowAt<SyntaxException>({1, 7 + depth - 1});
+    }
+}
+
+TEST_F(FullyParsedTest, explicit_stack_builds_same_tree) {
+    const std::string input =
+        "struct S { int x, str y }"
+        "variant V { int, S }"
+        "int f(ref S s, float g) {"
+        "    if -s.x * 2 + 1 >= 3 and not (g as int) == 1 {"
+        "        return {s.x, \"t\"};"
+        "    }"
+        "    while s.y is str { s.y = s.y + f(ref s, 1.5); }"
+        "}"
+        "const V v = {1, \"a\"};"
+        "f(ref v, {3, \"t\"});"
+        "void g() { print; }";
+
+    std::ostringstream recursive;
+    Init(input);
+    recursive << flatten(parser_->parseProgram());
+
+    std::ostringstream explicitStack;
+    Init(input, {.explicitStack = true});
+    explicitStack << flatten(parser_->parseProgram());
+
+    EXPECT_EQ(recursive.str(), explicitStack.str());
+}
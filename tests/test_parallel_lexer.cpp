@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include "lexer.hpp"
+#include "lexer_errors.hpp"
+#include "parallel_lexer.hpp"
+
+std::vector<Token> lexSequentially(std::string_view input) {
+    auto source = Source(input);
+    auto lexer = Lexer(source);
+
+    std::vector<Token> tokens;
+    do {
+        tokens.push_back(lexer.getToken());
+    } while (tokens.back().getType() != Token::Type::ETX);
+    return tokens;
+}
+
+TEST(FindChunkStartsTest, splits_after_new_lines) {
+    const std::string_view input{"a;\nb;\nc;\nd;\n"};
+
+    EXPECT_EQ(findChunkStarts(input, 1), std::vector<std::size_t>({0}));
+    EXPECT_EQ(findChunkStarts(input, 2), std::vector<std::size_t>({0, 6}));
+    EXPECT_EQ(findChunkStarts(input, 4), std::vector<std::size_t>({0, 3, 6, 9}));
+}
+
+TEST(FindChunkStartsTest, skips_str_consts_and_comments) {
+    const std::string_view input{"a = \"x\ny\\\"\n\";\n# \"\nb;\n"};
+
+    EXPECT_EQ(findChunkStarts(input, 8), std::vector<std::size_t>({0, 14, 18}));
+}
+
+TEST(ParallelLexerTest, getToken_same_as_lexer) {
+    const std::string_view input{
+        "int a = 1;\n"
+        "str s = \"multi\n"
+        "line \\\" # not a comment\";\n"
+        "# \"not a str\n"
+        "print s + a as str;\n"};
+    auto lexer = ParallelLexer(input, 4, 1);
+
+    for (const auto& expected : lexSequentially(input)) {
+        const auto token = lexer.getToken();
+        EXPECT_EQ(token.getType(), expected.getType());
+        EXPECT_EQ(token.getValue(), expected.getValue());
+        EXPECT_EQ(lexer.getText(token), Lexer::getText(expected, input));
+        EXPECT_EQ(token.getPosition().offset, expected.getPosition().offset);
+    }
+    EXPECT_EQ(lexer.getToken().getType(), Token::Type::ETX);
+
+    const auto lineColumn = lexer.getLineIndex().getLineColumn({52});
+    EXPECT_EQ(lineColumn.line, 4);
+    EXPECT_EQ(lineColumn.column, 1);
+}
+
+TEST(ParallelLexerTest, getToken_error_after_preceding_tokens) {
+    const std::string_view input{"a;\nb $;\nc;\n"};
+    auto lexer = ParallelLexer(input, 3, 1);
+
+    EXPECT_EQ(lexer.getToken().getType(), Token::Type::ID);
+    EXPECT_EQ(lexer.getToken().getType(), Token::Type::SEMI);
+    EXPECT_EQ(lexer.getToken().getType(), Token::Type::ID);
+    EXPECT_THROW(lexer.getToken(), InvalidToken);
+}
+
+TEST(ParallelLexerTest, getToken_invalid_utf8_in_later_chunk) {
+    const std::string_view input{"a;\nb\xc3(;\nc;\n"};
+    auto lexer = ParallelLexer(input, 3, 1);
+
+    EXPECT_EQ(lexer.getToken().getType(), Token::Type::ID);
+    EXPECT_EQ(lexer.getToken().getType(), Token::Type::SEMI);
+    EXPECT_EQ(lexer.getToken().getType(), Token::Type::ID);
+    try {
+        lexer.getToken();
+        FAIL() << "Expected InvalidUtf8";
+    } catch (const InvalidUtf8& e) {
+        EXPECT_EQ(e.getPosition().offset, 4);
+    }
+}
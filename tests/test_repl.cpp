@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include "repl.hpp"
+
+class ReplTest : public testing::Test {
+   protected:
+    std::stringstream output_;
+    std::stringstream errors_;
+    Repl repl_{output_, errors_};
+};
+
+TEST_F(ReplTest, feedLine_runs_complete_statements) {
+    EXPECT_FALSE(repl_.feedLine("int a = 1; print a;"));
+    EXPECT_EQ(output_.str(), "1\n");
+}
+
+TEST_F(ReplTest, feedLine_waits_for_unfinished_statement) {
+    EXPECT_TRUE(repl_.feedLine("print 1; void foo() {"));
+    EXPECT_EQ(output_.str(), "1\n") << "Complete statement should run right away";
+
+    EXPECT_TRUE(repl_.feedLine(R"(    print "a)"));
+    EXPECT_FALSE(repl_.feedLine(R"(b"; })"));
+    EXPECT_FALSE(repl_.feedLine("foo();"));
+
+    EXPECT_EQ(output_.str(), "1\na\nb\n");
+    EXPECT_EQ(errors_.str(), "");
+}
+
+TEST_F(ReplTest, feedLine_keeps_definitions) {
+    repl_.feedLine("struct Point { int x, int y }");
+    repl_.feedLine("int sum(Point p) { return p.x + p.y; }");
+    repl_.feedLine("Point p = {1, 2};");
+    repl_.feedLine("print sum(p);");
+
+    EXPECT_EQ(output_.str(), "3\n");
+    EXPECT_EQ(errors_.str(), "");
+}
+
+TEST_F(ReplTest, feedLine_recovers_from_errors) {
+    repl_.feedLine("void foo() { if true { print x; } }");
+    EXPECT_FALSE(repl_.feedLine("foo(); print 1;"));
+    EXPECT_FALSE(repl_.feedLine("print = ;"));
+
+    EXPECT_NE(errors_.str().find(" at 1:30"), std::string::npos);
+    EXPECT_NE(errors_.str().find(" at 3:7"), std::string::npos);
+
+    // The rest of the line is dropped after the error. Variables defined later land in
+    // the global scope, not in the blocks left by the error
+    repl_.feedLine("int x = 2; foo();");
+    EXPECT_EQ(output_.str(), "2\n");
+}
+
+TEST_F(ReplTest, finish_reports_unfinished_statement) {
+    EXPECT_TRUE(repl_.feedLine("print 1; print"));
+    repl_.finish();
+
+    EXPECT_EQ(output_.str(), "1\n");
+    EXPECT_NE(errors_.str().find(" at 2:1"), std::string::npos);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "scanner.hpp"
+
+/// Long enough to go through whole SIMD blocks as well as the scalar tail
+constexpr std::size_t inputSize{80};
+
+/// Parameter is the index of the character the scan should stop at
+class ScannerTest : public testing::TestWithParam<std::size_t> {};
+
+TEST_P(ScannerTest, skipWhiteSpace) {
+    const auto stopIndex = GetParam();
+    std::string input;
+    for (std::size_t i{0}; i < inputSize; ++i)
+        input.push_back(" \t\n\v\f\r"[i % 6]);
+    if (stopIndex < inputSize)
+        input[stopIndex] = '\x01';
+
+    const auto stop = skipWhiteSpace(input.data(), input.data() + input.size());
+    EXPECT_EQ(stop - input.data(), stopIndex);
+}
+
+TEST_P(ScannerTest, findLineEnd) {
+    const auto stopIndex = GetParam();
+    std::string input(inputSize, '\r');
+    if (stopIndex < inputSize)
+        input[stopIndex] = '\n';
+
+    const auto stop = findLineEnd(input.data(), input.data() + input.size());
+    EXPECT_EQ(stop - input.data(), stopIndex);
+}
+
+TEST_P(ScannerTest, findQuoteOrBackslash) {
+    const auto stopIndex = GetParam();
+    std::string input(inputSize, 'a');
+    if (stopIndex < inputSize)
+        input[stopIndex] = stopIndex % 2 ? '"' : '\\';
+
+    const auto stop = findQuoteOrBackslash(input.data(), input.data() + input.size());
+    EXPECT_EQ(stop - input.data(), stopIndex);
+}
+
+INSTANTIATE_TEST_SUITE_P(StopIndices, ScannerTest,
+                         testing::Range<std::size_t>(0, inputSize + 1));
+
+TEST(WhiteSpaceScannerTest, skipWhiteSpace_non_ascii) {
+    const std::string input(40, '\xa0');
+    EXPECT_EQ(skipWhiteSpace(input.data(), input.data() + input.size()), input.data());
+}
+
+TEST(Utf8ScannerTest, findInvalidUtf8_valid) {
+    std::string input;
+    for (int i{0}; i < 20; ++i)
+        input += "zażółć gęślą jaźń \xe2\x82\xac \xf0\x9f\x98\x80 ";
+
+    EXPECT_EQ(findInvalidUtf8(input.data(), input.data() + input.size()),
+              input.data() + input.size());
+}
+
+/// Parameter is an invalid sequence
+class InvalidUtf8Test : public testing::TestWithParam<std::string> {};
+
+TEST_P(InvalidUtf8Test, findInvalidUtf8_at_every_offset) {
+    for (std::size_t offset{0}; offset < inputSize; ++offset) {
+        std::string input(offset, 'a');
+        input += GetParam();
+        input += std::string(inputSize, 'b');
+
+        const auto invalid = findInvalidUtf8(input.data(), input.data() + input.size());
+        EXPECT_EQ(invalid - input.data(), offset)
+            << "At offset " << offset;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Sequences, InvalidUtf8Test,
+                         testing::Values("\x80", "\xc0\xaf", "\xc3", "\xe0\x80\xaf",
+                                         "\xed\xa0\x80", "\xe2\x82", "\xf0\x8f\xbf\xbf",
+                                         "\xf4\x90\x80\x80", "\xf0\x9f\x98", "\xff",
+                                         "\xc3\x28"));
+
+TEST(Utf8ScannerTest, findInvalidUtf8_cut_off_at_end) {
+    for (std::size_t offset{0}; offset < inputSize; ++offset) {
+        const auto input = std::string(offset, 'a') + "\xe2\x82";
+        const auto invalid = findInvalidUtf8(input.data(), input.data() + input.size());
+        EXPECT_EQ(invalid - input.data(), offset);
+    }
+}
+
+TEST(Utf8ScannerTest, countMissingUtf8Bytes) {
+    const std::string input{"a\xf0\x9f\x98"};
+
+    EXPECT_EQ(countMissingUtf8Bytes(input.data(), input.data() + 1), 0);
+    EXPECT_EQ(countMissingUtf8Bytes(input.data(), input.data() + 2), 3);
+    EXPECT_EQ(countMissingUtf8Bytes(input.data(), input.data() + 4), 1);
+}
@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <fstream>
+
+#include "mapped_file.hpp"
+#include "scanner.hpp"
 #include "source.hpp"
 
 class SourceTest : public testing::Test {
@@ -9,6 +14,10 @@ class SourceTest : public testing::Test {
         source_ = std::make_unique<Source>(stream_);
     }
 
+    LineColumn getLineColumn() const {
+        return source_->getLineIndex().getLineColumn(source_->getPosition());
+    }
+
     std::istringstream stream_;
     std::unique_ptr<Source> source_;
 };
@@ -16,7 +25,7 @@ class SourceTest : public testing::Test {
 TEST_F(SourceTest, getPosition) {
     Init("abc");
 
-    auto position = source_->getPosition();
+    auto position = getLineColumn();
     ASSERT_EQ(position.line, 1);
     ASSERT_EQ(position.column, 1);
 }
@@ -26,7 +35,7 @@ TEST_F(SourceTest, getPosition_after_nextChar) {
 
     source_->nextChar();
 
-    auto position = source_->getPosition();
+    auto position = getLineColumn();
     ASSERT_EQ(position.line, 1);
     ASSERT_EQ(position.column, 2);
 }
@@ -34,7 +43,7 @@ TEST_F(SourceTest, getPosition_after_nextChar) {
 TEST_F(SourceTest, getPosition_new_line_before_nextChar) {
     Init("\nabc");
 
-    auto position = source_->getPosition();
+    auto position = getLineColumn();
     ASSERT_EQ(position.line, 1);
     ASSERT_EQ(position.column, 1);
 }
@@ -44,7 +53,7 @@ TEST_F(SourceTest, getPosition_new_line_after_nextChar) {
 
     source_->nextChar();
 
-    auto position = source_->getPosition();
+    auto position = getLineColumn();
     ASSERT_EQ(position.line, 2);
     ASSERT_EQ(position.column, 1);
 }
@@ -62,3 +71,132 @@ TEST_F(SourceTest, getChar_after_nextChar) {
 
     ASSERT_EQ(source_->getChar(), 'b');
 }
+
+TEST_F(SourceTest, getChar_end_of_stream) {
+    Init("a");
+
+    source_->nextChar();
+    EXPECT_EQ(source_->getChar(), EOF);
+
+    source_->nextChar();
+    EXPECT_EQ(source_->getChar(), EOF);
+}
+
+TEST(BlockSourceTest, getChar_across_blocks) {
+    auto stream = std::istringstream("ab\ncde");
+    auto source = Source(stream, 2);
+
+    std::string read;
+    while (source.getChar() != EOF) {
+        read.push_back(source.getChar());
+        source.nextChar();
+    }
+    EXPECT_EQ(read, "ab\ncde");
+
+    auto position = source.getLineIndex().getLineColumn(source.getPosition());
+    EXPECT_EQ(position.line, 2);
+    EXPECT_EQ(position.column, 4);
+}
+
+TEST(BlockSourceTest, skip_across_blocks) {
+    auto stream = std::istringstream("    \n  x");
+    auto source = Source(stream, 2);
+
+    std::string skipped;
+    source.skip(skipWhiteSpace, &skipped);
+
+    EXPECT_EQ(skipped, "    \n  ");
+    EXPECT_EQ(source.getChar(), 'x');
+    EXPECT_EQ(source.getPosition().offset, 7);
+}
+
+TEST_F(SourceTest, getPosition_offset) {
+    Init("ab\ncd");
+
+    for (int i{0}; i < 4; ++i)
+        source_->nextChar();
+
+    EXPECT_EQ(source_->getPosition().offset, 4);
+    auto position = getLineColumn();
+    EXPECT_EQ(position.line, 2);
+    EXPECT_EQ(position.column, 2);
+}
+
+TEST(LineIndexTest, getLineColumn_unknown_position) {
+    const LineIndex lineIndex;
+
+    const auto lineColumn = lineIndex.getLineColumn({});
+    EXPECT_EQ(lineColumn.line, 0);
+    EXPECT_EQ(lineColumn.column, 0);
+}
+
+TEST(LineIndexTest, getLineColumn_across_blocks) {
+    LineIndex lineIndex;
+    lineIndex.addBlock("a\nb", 0);
+    lineIndex.addBlock("\n\nc", 3);
+
+    const auto lineColumn = lineIndex.getLineColumn({5});
+    EXPECT_EQ(lineColumn.line, 4);
+    EXPECT_EQ(lineColumn.column, 1);
+}
+
+TEST(BufferSourceTest, getChar_and_getPosition) {
+    auto source = Source(std::string_view("a\nb"));
+
+    EXPECT_EQ(source.getChar(), 'a');
+    source.nextChar();
+    EXPECT_EQ(source.getChar(), '\n');
+    source.nextChar();
+    EXPECT_EQ(source.getChar(), 'b');
+
+    auto position = source.getLineIndex().getLineColumn(source.getPosition());
+    EXPECT_EQ(position.line, 2);
+    EXPECT_EQ(position.column, 1);
+
+    source.nextChar();
+    EXPECT_EQ(source.getChar(), EOF);
+}
+
+TEST(BufferSourceTest, getChar_empty_buffer) {
+    auto source = Source(std::string_view());
+
+    EXPECT_EQ(source.getChar(), EOF);
+    source.nextChar();
+    EXPECT_EQ(source.getChar(), EOF);
+}
+
+TEST(MappedFileTest, getContents) {
+    const auto path =
+        std::filesystem::temp_directory_path() / "raptor_mapped_file_test.rp";
+    std::ofstream(path) << "print 1;";
+
+    {
+        const MappedFile file(path);
+        EXPECT_EQ(file.getContents(), "print 1;");
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(MappedFileTest, getContents_empty_file) {
+    const auto path =
+        std::filesystem::temp_directory_path() / "raptor_empty_file_test.rp";
+    std::ofstream{path};
+
+    {
+        const MappedFile file(path);
+        EXPECT_TRUE(file.getContents().empty());
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(MappedFileTest, missing_file) {
+    EXPECT_THROW(MappedFile("/nonexistent/raptor_file.rp"), std::system_error);
+}
+
+TEST(SourceLimitTest, buffer_ending_past_max_offset) {
+    const std::string_view buffer{"ab"};
+
+    EXPECT_NO_THROW(Source(buffer, Position::maxOffset - 2));
+    EXPECT_THROW(Source(buffer, Position::maxOffset - 1), SourceTooLarge);
+    EXPECT_THROW(Source(buffer, Position::unknownOffset), SourceTooLarge);
+}
@@ -172,8 +172,8 @@ TEST_F(FullyParsedTest, parse_func_def_id_ret_type) {
     ASSERT_EQ(prog.statements.size(), 1);
     const auto funcDef = dynamic_cast<FuncDef*>(prog.statements.at(0).get());
     ASSERT_TRUE(funcDef);
-    ASSERT_TRUE(std::holds_alternative<std::string>(funcDef->getReturnType()));
-    EXPECT_EQ(std::get<std::string>(funcDef->getReturnType()), "MyStruct");
+    ASSERT_TRUE(std::holds_alternative<Symbol>(funcDef->getReturnType()));
+    EXPECT_EQ(std::get<Symbol>(funcDef->getReturnType()), "MyStruct");
 }
 
 TEST_F(FullyParsedTest, parse_func_def_parameter) {
@@ -208,8 +208,8 @@ TEST_F(FullyParsedTest, parse_func_def_id_parameter) {
     ASSERT_EQ(funcDef->getParameters().size(), 1);
 
     const auto& param = funcDef->getParameters().at(0);
-    ASSERT_TRUE(std::holds_alternative<std::string>(param.type));
-    EXPECT_EQ(std::get<std::string>(param.type), "MyInt");
+    ASSERT_TRUE(std::holds_alternative<Symbol>(param.type));
+    EXPECT_EQ(std::get<Symbol>(param.type), "MyInt");
     EXPECT_EQ(param.name, "num");
 }
 
@@ -323,8 +323,8 @@ TEST_F(FullyParsedTest, parse_assignment) {
     ASSERT_EQ(prog.statements.size(), 1);
     const auto assignment = dynamic_cast<Assignment*>(prog.statements.at(0).get());
     ASSERT_TRUE(assignment);
-    ASSERT_TRUE(std::holds_alternative<std::string>(assignment->lhs));
-    EXPECT_EQ(std::get<std::string>(assignment->lhs), "var");
+    ASSERT_TRUE(std::holds_alternative<Symbol>(assignment->lhs));
+    EXPECT_EQ(std::get<Symbol>(assignment->lhs), "var");
 
     const auto expression = dynamic_cast<Constant*>(assignment->rhs.get());
     ASSERT_TRUE(expression);
@@ -341,18 +341,18 @@ TEST_F(FullyParsedTest, parse_field_assignment) {
     const auto assignment = dynamic_cast<Assignment*>(prog.statements.at(0).get());
     ASSERT_TRUE(assignment);
 
-    ASSERT_TRUE(std::holds_alternative<std::unique_ptr<FieldAccess>>(assignment->lhs));
-    const auto& fieldAccess = std::get<std::unique_ptr<FieldAccess>>(assignment->lhs);
+    ASSERT_TRUE(std::holds_alternative<ArenaPtr<FieldAccess>>(assignment->lhs));
+    const auto& fieldAccess = std::get<ArenaPtr<FieldAccess>>(assignment->lhs);
     EXPECT_EQ(fieldAccess->field, "secondField");
 
     ASSERT_TRUE(
-        std::holds_alternative<std::unique_ptr<FieldAccess>>(fieldAccess->container));
+        std::holds_alternative<ArenaPtr<FieldAccess>>(fieldAccess->container));
     const auto& innerFieldAccess =
-        std::get<std::unique_ptr<FieldAccess>>(fieldAccess->container);
+        std::get<ArenaPtr<FieldAccess>>(fieldAccess->container);
     EXPECT_EQ(innerFieldAccess->field, "firstField");
 
-    ASSERT_TRUE(std::holds_alternative<std::string>(innerFieldAccess->container));
-    ASSERT_EQ(std::get<std::string>(innerFieldAccess->container), "myStruct");
+    ASSERT_TRUE(std::holds_alternative<Symbol>(innerFieldAccess->container));
+    ASSERT_EQ(std::get<Symbol>(innerFieldAccess->container), "myStruct");
 
     const auto expression = dynamic_cast<Constant*>(assignment->rhs.get());
     ASSERT_TRUE(expression);
@@ -410,8 +410,8 @@ TEST_F(FullyParsedTest, parse_const_var_def_id_type) {
     const auto varDef = dynamic_cast<VarDef*>(prog.statements.at(0).get());
     ASSERT_TRUE(varDef);
 
-    ASSERT_TRUE(std::holds_alternative<std::string>(varDef->type));
-    EXPECT_EQ(std::get<std::string>(varDef->type), "MyStruct");
+    ASSERT_TRUE(std::holds_alternative<Symbol>(varDef->type));
+    EXPECT_EQ(std::get<Symbol>(varDef->type), "MyStruct");
 }
 
 TEST_F(ParserTest, parse_const_var_def_invalid_type) {
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include "fixtures.hpp"
+#include "lexer.hpp"
+#include "lexer_errors.hpp"
+#include "threaded_lexer.hpp"
+
+TEST(ThreadedLexerTest, getToken_in_order) {
+    auto lexer = FakeLexer({Token::Type::ID, Token::Type::ASGN_OP, Token::Type::INT_CONST,
+                            Token::Type::SEMI});
+    auto threadedLexer = ThreadedLexer(lexer);
+
+    EXPECT_EQ(threadedLexer.getToken().getType(), Token::Type::ID);
+    EXPECT_EQ(threadedLexer.getToken().getType(), Token::Type::ASGN_OP);
+    EXPECT_EQ(threadedLexer.getToken().getType(), Token::Type::INT_CONST);
+    EXPECT_EQ(threadedLexer.getToken().getType(), Token::Type::SEMI);
+    EXPECT_EQ(threadedLexer.getToken().getType(), Token::Type::ETX);
+    EXPECT_EQ(threadedLexer.getToken().getType(), Token::Type::ETX);
+}
+
+TEST(ThreadedLexerTest, getToken_error_after_preceding_tokens) {
+    auto source = Source(std::string_view("a; $ b;"));
+    auto lexer = Lexer(source);
+    auto threadedLexer = ThreadedLexer(lexer);
+
+    EXPECT_EQ(threadedLexer.getToken().getType(), Token::Type::ID);
+    EXPECT_EQ(threadedLexer.getToken().getType(), Token::Type::SEMI);
+    EXPECT_THROW(threadedLexer.getToken(), InvalidToken);
+    EXPECT_THROW(threadedLexer.getToken(), InvalidToken);
+}
+
+TEST(ThreadedLexerTest, getTokens_defers_error) {
+    auto source = Source(std::string_view("a; $"));
+    auto lexer = Lexer(source);
+    auto threadedLexer = ThreadedLexer(lexer);
+
+    std::vector<Token> tokens(8);
+    ASSERT_EQ(threadedLexer.getTokens(tokens), 2);
+    EXPECT_EQ(tokens[1].getType(), Token::Type::SEMI);
+    EXPECT_THROW(threadedLexer.getTokens(tokens), InvalidToken);
+}
+
+TEST(ThreadedLexerTest, destroy_before_end_of_text) {
+    const auto statements = 4 * ThreadedLexer::ringCapacity * ThreadedLexer::batchSize;
+    std::string input;
+    for (std::size_t i{0}; i < statements; ++i)
+        input += "a;";
+    auto source = Source(std::string_view(input));
+    auto lexer = Lexer(source);
+
+    auto threadedLexer = ThreadedLexer(lexer);
+    EXPECT_EQ(threadedLexer.getToken().getType(), Token::Type::ID);
+}